@@ -0,0 +1,93 @@
+#! /usr/bin/env python
+
+# This script checks the initial plotfile of `inputs`: a gaussian beam
+# whose particles are drawn with the Philox4x32-10 counter-based
+# generator. The particle of index i gets the normal deviates of the
+# counter i and streams 0, 1 and 2, whatever the number of MPI ranks and
+# threads. The beam is regenerated here with a numpy implementation of
+# Philox (checked against its known-answer vector) and compared with the
+# particles of the plotfile.
+import sys
+import yt
+yt.funcs.mylog.setLevel(50)
+import numpy as np
+from scipy.constants import c, m_e
+
+# this will be the name of the plot file
+fn = sys.argv[1]
+
+# Parameters (these parameters must match the parameters in `inputs`)
+x_m, y_m, z_m = 0.2, -0.1, 0.05
+x_rms, y_rms, z_rms = 0.1, 0.15, 0.2
+u_m = [0.1, 0., 1.]
+u_th = [0.01, 0.02, 0.03]
+npart = 8192
+# Key of the generator (electrons.random_seed)
+key = 1234
+
+mask = np.uint64(0xFFFFFFFF)
+
+def mulhilo( a, b ):
+    p = np.uint64(a)*b
+    return p >> np.uint64(32), p & mask
+
+def philox4x32( key, counter, stream ):
+    counter = np.asarray(counter, dtype=np.uint64)
+    c0 = counter & mask
+    c1 = counter >> np.uint64(32)
+    c2 = np.full_like(counter, stream)
+    c3 = np.zeros_like(counter)
+    k0 = np.uint64(key & 0xFFFFFFFF)
+    k1 = np.uint64(key >> 32)
+    for r in range(10):
+        if r > 0:
+            k0 = (k0 + np.uint64(0x9E3779B9)) & mask
+            k1 = (k1 + np.uint64(0xBB67AE85)) & mask
+        hi0, lo0 = mulhilo(0xD2511F53, c0)
+        hi1, lo1 = mulhilo(0xCD9E8D57, c2)
+        c0, c1, c2, c3 = hi1 ^ c1 ^ k0, lo1, hi0 ^ c3 ^ k1, lo0
+    return c0, c1, c2, c3
+
+def uniform( a, b ):
+    u = (a << np.uint64(32)) | b
+    return ((u >> np.uint64(11)).astype(np.float64) + 0.5)/9007199254740992.
+
+def normal2( key, counter, stream ):
+    r = philox4x32(key, counter, stream)
+    rho = np.sqrt(-2.*np.log(uniform(r[0], r[1])))
+    theta = 2.*np.pi*uniform(r[2], r[3])
+    return rho*np.cos(theta), rho*np.sin(theta)
+
+# Known-answer vector of Philox4x32-10 (counter 0, key 0)
+kat = philox4x32(0, [0], 0)
+assert [int(v[0]) for v in kat] == [0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8]
+
+# Regenerate the beam
+i = np.arange(npart)
+n0, n1 = normal2(key, i, 0)
+n2, n3 = normal2(key, i, 1)
+n4, n5 = normal2(key, i, 2)
+beam = np.array([ x_m + x_rms*n0, y_m + y_rms*n1, z_m + z_rms*n2,
+                  m_e*c*(u_m[0] + u_th[0]*n3),
+                  m_e*c*(u_m[1] + u_th[1]*n4),
+                  m_e*c*(u_m[2] + u_th[2]*n5) ])
+
+ds = yt.load( fn )
+ad = ds.all_data()
+sim = np.array([ ad['electrons', 'particle_' + f].to_ndarray() for f in
+                 ['position_x', 'position_y', 'position_z',
+                  'momentum_x', 'momentum_y', 'momentum_z'] ])
+
+# All the particles are in the domain: none is lost
+assert sim.shape == beam.shape
+
+# The particle order depends on the decomposition: sort both by x
+beam = beam[:, np.argsort(beam[0])]
+sim = sim[:, np.argsort(sim[0])]
+max_error = 0.
+for b, s in zip(beam, sim):
+    error = np.max(np.abs(s - b))/np.max(np.abs(b))
+    max_error = max(max_error, error)
+print('Max relative error: %.2e' %max_error)
+# Allow for the last-bit differences of the libm functions
+assert max_error < 1.e-12
@@ -0,0 +1,58 @@
+#! /usr/bin/env python
+
+# This script checks the initial plotfile of `inputs`: a plasma whose
+# density is given by a parsed function that uses all the operators and
+# builtin functions of the parser, and user-defined functions. The weight
+# of each particle must be the density, evaluated here with numpy at the
+# particle position, times the volume per particle.
+import sys
+import yt
+yt.funcs.mylog.setLevel(50)
+import numpy as np
+
+# this will be the name of the plot file
+fn = sys.argv[1]
+
+# Parameters (these parameters must match the parameters in `inputs`)
+n0 = 1.e20
+L = 1.e-5
+k = 314159.2653589793
+nx = 16
+dx = 2.*L/nx
+num_ppc = 8
+
+def bump( u, v ):
+    return np.exp(-(u**2+v**2)/L**2)
+
+def ramp( s ):
+    return (s>-0.5*L)*(s<0.5*L)*(s/L+0.5) + (s>=0.5*L)
+
+def density( x, y, z ):
+    return n0*( 3. + np.sin(k*x)*np.cos(k*y)*np.tan(0.25*k*z)
+        + 0.25*np.tanh(x/L)*np.cosh(y/L) - 0.1*np.sinh(z/L)
+        + bump(x,y)
+        + np.sqrt(np.abs(x*y))/L + np.log(2. + z/L) - np.log10(3. + x/L)
+        + 0.2*np.arctan(y/L) + 0.1*np.arcsin(0.5*x/L) + 0.1*np.arccos(0.5*y/L)
+        + 0.3*(x>0)*(y<=0) + 0.2*(z>=x) - 0.2*(y<z) + 0.1*(x==y) + 0.1*(x!=z)
+        + 0.1*np.logical_and(x>0, z<0) + 0.1*np.logical_or(y>0, z>0)
+        + 0.1*np.maximum(x,z)/L - 0.1*np.minimum(y,z)/L
+        + 0.1*np.heaviside(x,0.5)
+        + 0.1*np.power(np.abs(z)/L, 1.5) + (x/L)**2*(y/L)**3
+        - 0.01*(z/L+2.)**(-2) + 0.1*L/(x+2.*L)
+        + 0.5*ramp(z)*bump(y,z) + 0.2*ramp(ramp(x)*L) )
+
+ds = yt.load( fn )
+ad = ds.all_data()
+x = ad['electrons', 'particle_position_x'].to_ndarray()
+y = ad['electrons', 'particle_position_y'].to_ndarray()
+z = ad['electrons', 'particle_position_z'].to_ndarray()
+w = ad['electrons', 'particle_weight'].to_ndarray()
+
+# No particle is below the (default) density_min of 0
+assert len(w) == nx**3*num_ppc
+
+w_th = density(x, y, z)*dx**3/num_ppc
+max_error = np.max( np.abs(w - w_th)/w_th )
+print('Max relative error on the weights: %.2e' %max_error)
+# Allow for the last-bit differences of the libm functions
+assert max_error < 1.e-12
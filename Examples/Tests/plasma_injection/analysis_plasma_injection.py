@@ -0,0 +1,56 @@
+#! /usr/bin/env python
+
+# This script checks the initial plotfile of `inputs`. Particles are only
+# created where the density is not below density_min and inside the
+# species bounds, so that the number of particles is known exactly:
+# - `uniform` has 2x2x2 particles per cell at known positions, which are
+#   compared with the expected ones.
+# - `random` has 4 particles per cell at random positions, in the cells
+#   where x<0 and z>=0.25 (these limits are cell boundaries).
+# The IDs of the particles of each species must be unique.
+import sys
+import yt
+yt.funcs.mylog.setLevel(50)
+import numpy as np
+
+# this will be the name of the plot file
+fn = sys.argv[1]
+
+# Parameters (these parameters must match the parameters in `inputs`)
+n0 = 1.e20
+nx = 16
+lo = -1.
+dx = 2./nx
+
+ds = yt.load( fn )
+ad = ds.all_data()
+
+def get( species, field ):
+    return ad[species, 'particle_' + field].to_ndarray()
+
+# Uniform species: expected positions
+u = lo + dx*(np.arange(2*nx)//2 + 0.25 + 0.5*(np.arange(2*nx)%2))
+x, y, z = np.meshgrid(u, u, u, indexing='ij')
+inside = (x >= -0.3) & (x < 0.55) & (z >= -0.7) & (z < 0.2) & (y < 0.1)
+expected = np.array([x[inside], y[inside], z[inside]])
+sim = np.array([get('uniform', 'position_' + d) for d in 'xyz'])
+print('uniform: %d particles, %d expected' %(sim.shape[1], expected.shape[1]))
+assert sim.shape == expected.shape
+expected = expected[:, np.lexsort(expected[::-1])]
+sim = sim[:, np.lexsort(sim[::-1])]
+assert np.max(np.abs(sim - expected)) < 1.e-14
+assert np.allclose(get('uniform', 'weight'), n0*dx**3/8, rtol=1.e-14, atol=0.)
+
+# Random species: number of particles, bounds and weights
+x = get('random', 'position_x')
+z = get('random', 'position_z')
+n_expected = 4*(nx//2)*nx*(nx - int(round((0.25-lo)/dx)))
+print('random: %d particles, %d expected' %(len(x), n_expected))
+assert len(x) == n_expected
+assert np.all(x < 0.) and np.all(z >= 0.25)
+assert np.allclose(get('random', 'weight'), n0*dx**3/4, rtol=1.e-14, atol=0.)
+
+# Unique IDs
+for species in ['uniform', 'random']:
+    ids = get(species, 'id')
+    assert len(np.unique(ids)) == len(ids)
@@ -101,6 +101,8 @@ def _array1d_from_pointer(pointer, dtype, size):
 libwarpx.amrex_init.argtypes = (ctypes.c_int, _LP_LP_c_char)
 libwarpx.warpx_getParticleStructs.restype = _LP_particle_p
 libwarpx.warpx_getParticleArrays.restype = _LP_LP_c_double
+libwarpx.warpx_getParticleCompIndex.restype = ctypes.c_int
+libwarpx.warpx_getParticleCompIndex.argtypes = (ctypes.c_int, ctypes.c_char_p)
 libwarpx.warpx_getEfield.restype = _LP_LP_c_double
 libwarpx.warpx_getEfieldLoVects.restype = _LP_c_int
 libwarpx.warpx_getEfieldCP.restype = _LP_LP_c_double
@@ -400,6 +402,38 @@ def get_particle_arrays(species_number, comp):
     return particle_data
 
 
+def get_particle_comp_index(species_number, pid_name):
+    '''
+
+    Get the component index for a given particle attribute. This is needed
+    for the attributes added at runtime, such as the fields saved on the
+    particles.
+
+    Parameters
+    ----------
+
+        species_number : the species id
+        pid_name       : the name of the attribute, e.g. 'Ex' or 'theta'
+
+    Returns
+    -------
+
+        The component index, or -1 if the species does not have this attribute.
+
+    '''
+
+    return libwarpx.warpx_getParticleCompIndex(species_number,
+                                               pid_name.encode('utf-8'))
+
+
+def _get_particle_field(species_number, field_name):
+    comp = get_particle_comp_index(species_number, field_name)
+    if comp < 0:
+        raise Exception('get_particle_%s: fields are only stored on the particles '
+                        'with <species>.save_fields_on_particles = 1' % field_name)
+    return get_particle_arrays(species_number, comp)
+
+
 def get_particle_x(species_number):
     '''
 
@@ -529,7 +563,7 @@ def get_particle_Ex(species_number):
 
     '''
 
-    return get_particle_arrays(species_number, 4)
+    return _get_particle_field(species_number, 'Ex')
 
 
 def get_particle_Ey(species_number):
@@ -540,7 +574,7 @@ def get_particle_Ey(species_number):
 
     '''
 
-    return get_particle_arrays(species_number, 5)
+    return _get_particle_field(species_number, 'Ey')
 
 
 def get_particle_Ez(species_number):
@@ -551,7 +585,7 @@ def get_particle_Ez(species_number):
 
     '''
 
-    return get_particle_arrays(species_number, 6)
+    return _get_particle_field(species_number, 'Ez')
 
 
 def get_particle_Bx(species_number):
@@ -562,7 +596,7 @@ def get_particle_Bx(species_number):
 
     '''
 
-    return get_particle_arrays(species_number, 7)
+    return _get_particle_field(species_number, 'Bx')
 
 
 def get_particle_By(species_number):
@@ -573,7 +607,7 @@ def get_particle_By(species_number):
 
     '''
 
-    return get_particle_arrays(species_number, 8)
+    return _get_particle_field(species_number, 'By')
 
 
 def get_particle_Bz(species_number):
@@ -584,7 +618,7 @@ def get_particle_Bz(species_number):
 
     '''
 
-    return get_particle_arrays(species_number, 9)
+    return _get_particle_field(species_number, 'Bz')
 
 
 def get_particle_theta(species_number):
@@ -596,7 +630,8 @@ def get_particle_theta(species_number):
     '''
 
     if geometry_dim == 'rz':
-        return get_particle_arrays(species_number, 10)
+        return get_particle_arrays(species_number,
+                                   get_particle_comp_index(species_number, 'theta'))
     elif geometry_dim == '3d':
         return [np.arctan2(struct['y'], struct['x']) for struct in structs]
     elif geometry_dim == '2d':
@@ -815,32 +815,23 @@ PushPMLPSATDSinglePatch (
     // (Exy, Ezx, etc.) and the component (0 or 1) of the
     // MultiFabs (e.g. pml_E) is dictated by the
     // function that damps the PML
-    solver.ForwardTransform(*pml_E[0], Idx::Exy, 0);
-    solver.ForwardTransform(*pml_E[0], Idx::Exz, 1);
-    solver.ForwardTransform(*pml_E[1], Idx::Eyz, 0);
-    solver.ForwardTransform(*pml_E[1], Idx::Eyx, 1);
-    solver.ForwardTransform(*pml_E[2], Idx::Ezx, 0);
-    solver.ForwardTransform(*pml_E[2], Idx::Ezy, 1);
-    solver.ForwardTransform(*pml_B[0], Idx::Bxy, 0);
-    solver.ForwardTransform(*pml_B[0], Idx::Bxz, 1);
-    solver.ForwardTransform(*pml_B[1], Idx::Byz, 0);
-    solver.ForwardTransform(*pml_B[1], Idx::Byx, 1);
-    solver.ForwardTransform(*pml_B[2], Idx::Bzx, 0);
-    solver.ForwardTransform(*pml_B[2], Idx::Bzy, 1);
+    // (batched: the components are transformed by groups)
+    solver.ForwardTransform(
+        {pml_E[0].get(), pml_E[0].get(), pml_E[1].get(), pml_E[1].get(),
+         pml_E[2].get(), pml_E[2].get(), pml_B[0].get(), pml_B[0].get(),
+         pml_B[1].get(), pml_B[1].get(), pml_B[2].get(), pml_B[2].get()},
+        {Idx::Exy, Idx::Exz, Idx::Eyz, Idx::Eyx, Idx::Ezx, Idx::Ezy,
+         Idx::Bxy, Idx::Bxz, Idx::Byz, Idx::Byx, Idx::Bzx, Idx::Bzy},
+        {0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1});
     // Advance fields in spectral space
     solver.pushSpectralFields();
     // Perform backward Fourier Transform
-    solver.BackwardTransform(*pml_E[0], Idx::Exy, 0);
-    solver.BackwardTransform(*pml_E[0], Idx::Exz, 1);
-    solver.BackwardTransform(*pml_E[1], Idx::Eyz, 0);
-    solver.BackwardTransform(*pml_E[1], Idx::Eyx, 1);
-    solver.BackwardTransform(*pml_E[2], Idx::Ezx, 0);
-    solver.BackwardTransform(*pml_E[2], Idx::Ezy, 1);
-    solver.BackwardTransform(*pml_B[0], Idx::Bxy, 0);
-    solver.BackwardTransform(*pml_B[0], Idx::Bxz, 1);
-    solver.BackwardTransform(*pml_B[1], Idx::Byz, 0);
-    solver.BackwardTransform(*pml_B[1], Idx::Byx, 1);
-    solver.BackwardTransform(*pml_B[2], Idx::Bzx, 0);
-    solver.BackwardTransform(*pml_B[2], Idx::Bzy, 1);
+    solver.BackwardTransform(
+        {pml_E[0].get(), pml_E[0].get(), pml_E[1].get(), pml_E[1].get(),
+         pml_E[2].get(), pml_E[2].get(), pml_B[0].get(), pml_B[0].get(),
+         pml_B[1].get(), pml_B[1].get(), pml_B[2].get(), pml_B[2].get()},
+        {Idx::Exy, Idx::Exz, Idx::Eyz, Idx::Eyx, Idx::Ezx, Idx::Ezy,
+         Idx::Bxy, Idx::Bxz, Idx::Byz, Idx::Byx, Idx::Bzx, Idx::Bzy},
+        {0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1});
 }
 #endif
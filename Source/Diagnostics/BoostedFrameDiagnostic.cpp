@@ -446,6 +446,81 @@ namespace
 
 namespace
 {
+/* Write the particle data of one species, for one lab-frame buffer, into
+   one binary file per attribute on this rank. This does not communicate
+   and may run on the background I/O thread.
+*/
+void
+WriteParticleFiles(const WarpXParticleContainer::DiagnosticParticleData& pdata,
+                   const std::string& name, const int i_lab, const int MyProc)
+{
+    std::string field_name;
+    std::ofstream ofs;
+
+    auto np = pdata.GetRealData(DiagIdx::w).size();
+
+    if (np == 0) return;
+
+    field_name = name + Concatenate("w_", i_lab, 5) + "_" + std::to_string(MyProc);
+    ofs.open(field_name.c_str(), std::ios::out|std::ios::binary);
+    writeRealData(pdata.GetRealData(DiagIdx::w).data(), np, ofs);
+    ofs.close();
+
+    field_name = name + Concatenate("x_", i_lab, 5) + "_" + std::to_string(MyProc);
+    ofs.open(field_name.c_str(), std::ios::out|std::ios::binary);
+    writeRealData(pdata.GetRealData(DiagIdx::x).data(), np, ofs);
+    ofs.close();    
+
+    field_name = name + Concatenate("y_", i_lab, 5) + "_" + std::to_string(MyProc);
+    ofs.open(field_name.c_str(), std::ios::out|std::ios::binary);
+    writeRealData(pdata.GetRealData(DiagIdx::y).data(), np, ofs);
+    ofs.close();    
+
+    field_name = name + Concatenate("z_", i_lab, 5) + "_" + std::to_string(MyProc);
+    ofs.open(field_name.c_str(), std::ios::out|std::ios::binary);
+    writeRealData(pdata.GetRealData(DiagIdx::z).data(), np, ofs);
+    ofs.close();    
+    
+    field_name = name + Concatenate("ux_", i_lab, 5) + "_" + std::to_string(MyProc);
+    ofs.open(field_name.c_str(), std::ios::out|std::ios::binary);
+    writeRealData(pdata.GetRealData(DiagIdx::ux).data(), np, ofs);
+    ofs.close();    
+
+    field_name = name + Concatenate("uy_", i_lab, 5) + "_" + std::to_string(MyProc);
+    ofs.open(field_name.c_str(), std::ios::out|std::ios::binary);
+    writeRealData(pdata.GetRealData(DiagIdx::uy).data(), np, ofs);
+    ofs.close();    
+
+    field_name = name + Concatenate("uz_", i_lab, 5) + "_" + std::to_string(MyProc);
+    ofs.open(field_name.c_str(), std::ios::out|std::ios::binary);
+    writeRealData(pdata.GetRealData(DiagIdx::uz).data(), np, ofs);
+    ofs.close();
+}
+
+
+/* Write the particle data of this rank into its slot of the aggregated
+   particle file of one species. The file holds, for each flush, one
+   contiguous block with the attributes w, x, y, z, ux, uy, uz stored one
+   after the other (total_np values each); this rank's particles start at
+   rank_offset within each attribute. The file must already exist.
+*/
+void
+WriteParticleBlock(const WarpXParticleContainer::DiagnosticParticleData& pdata,
+                   const std::string& file_name, const long file_offset,
+                   const long total_np, const long rank_offset)
+{
+    const long np = pdata.GetRealData(DiagIdx::w).size();
+    if (np == 0) return;
+
+    std::fstream ofs(file_name.c_str(), std::ios::in|std::ios::out|std::ios::binary);
+    if (!ofs.good()) amrex::FileOpenFailed(file_name);
+    for (int k = 0; k < DiagIdx::nattribs; ++k) {
+        ofs.seekp(file_offset + (k*total_np + rank_offset)*sizeof(Real));
+        writeRealData(pdata.GetRealData(k).data(), np, ofs);
+    }
+    ofs.close();
+}
+
     void
     CopySlice(MultiFab& tmp, MultiFab& buf, int k_lab, 
               const Gpu::ManagedDeviceVector<int>& map_actual_fields_to_dump)
@@ -519,6 +594,131 @@ LorentzTransformZ(MultiFab& data, Real gamma_boost, Real beta_boost, int ncomp)
         );
     }
 }
+
+/* Cell-center the fields of level 0 on the two cell planes that bracket
+   z_boost, directly from the staggered fields, and linearly interpolate them
+   onto the plane of index i_boost. The result has the layout of the data
+   returned by WarpX::GetCellCenteredData (Ex Ey Ez Bx By Bz jx jy jz rho),
+   and lives on the transverse boxes of the lab-frame buffer (distribution
+   mapping dm). A nullptr in src leaves the corresponding component at 0.
+*/
+std::unique_ptr<MultiFab>
+GetCellCenteredSlice(const std::array<const MultiFab*, 10>& src,
+                     const Geometry& geom, int dir, Real z_boost, int i_boost,
+                     int max_box_size, const DistributionMapping& dm)
+{
+    BL_PROFILE("BoostedFrameDiagnostic::GetCellCenteredSlice");
+
+    const int ncomp = 10;
+    const Box& domain = geom.Domain();
+
+    // Index of the cell center just below z_boost, and interpolation weight
+    const Real zc = (z_boost - geom.ProbLo(dir))/geom.CellSize(dir) - 0.5;
+    int il = domain.smallEnd(dir) + static_cast<int>(std::floor(zc));
+    il = std::max(domain.smallEnd(dir), std::min(il, domain.bigEnd(dir)-1));
+    const Real w = std::max(0.0, std::min(1.0, zc - (il - domain.smallEnd(dir))));
+
+    Box slab_box = domain;
+    slab_box.setSmall(dir, il);
+    slab_box.setBig(dir, il+1);
+
+    // Pieces of the level-0 grids that intersect the slab, on the rank
+    // that owns the corresponding grid so that no communication is needed
+    const BoxArray cba = amrex::convert(src[0]->boxArray(), IntVect::TheCellVector());
+    const DistributionMapping& src_dm = src[0]->DistributionMap();
+    BoxList piece_bl;
+    Vector<int> piece_procs;
+    Vector<int> piece_to_src;
+    for (int ib = 0; ib < cba.size(); ++ib) {
+        const Box b = cba[ib] & slab_box;
+        if (b.ok()) {
+            piece_bl.push_back(b);
+            piece_procs.push_back(src_dm[ib]);
+            piece_to_src.push_back(ib);
+        }
+    }
+    BoxArray piece_ba(piece_bl);
+    DistributionMapping piece_dm(piece_procs);
+    MultiFab piece(piece_ba, piece_dm, ncomp, 0);
+
+    for (MFIter mfi(piece); mfi.isValid(); ++mfi) {
+        const Box& bx = mfi.validbox();
+        const int isrc = piece_to_src[mfi.index()];
+        Array4<Real> piece_arr = piece[mfi].array();
+        for (int comp = 0; comp < ncomp; ++comp) {
+            if (src[comp] == nullptr) {
+                ParallelFor(bx,
+                    [=] AMREX_GPU_DEVICE (int i, int j, int k)
+                    {
+                        piece_arr(i,j,k,comp) = 0.0;
+                    }
+                );
+                continue;
+            }
+            Array4<const Real> src_arr = (*src[comp])[isrc].array();
+            // Average over the 1, 2, 4 or 8 points surrounding the cell
+            // center, depending on the staggering of the field
+            const IntVect stag = src[comp]->ixType().toIntVect();
+            const int sx = stag[0];
+#if (AMREX_SPACEDIM == 3)
+            const int sy = stag[1];
+            const int sz = stag[2];
+#else
+            const int sy = stag[1];
+            const int sz = 0;
+#endif
+            const Real inv_npts = 1.0/((1+sx)*(1+sy)*(1+sz));
+            ParallelFor(bx,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k)
+                {
+                    Real sum = 0.0;
+                    for (int c = 0; c <= sz; ++c) {
+                    for (int b = 0; b <= sy; ++b) {
+                    for (int a = 0; a <= sx; ++a) {
+                        sum += src_arr(i+a, j+b, k+c);
+                    }}}
+                    piece_arr(i,j,k,comp) = sum*inv_npts;
+                }
+            );
+        }
+    }
+
+    // Gather the two planes on the boxes of the lab-frame buffer
+    BoxArray slab_ba(slab_box);
+    slab_ba.maxSize(max_box_size);
+    MultiFab slab(slab_ba, dm, ncomp, 0);
+    slab.ParallelCopy(piece, 0, 0, ncomp);
+
+    BoxList slice_bl;
+    for (int ib = 0; ib < slab_ba.size(); ++ib) {
+        Box b = slab_ba[ib];
+        b.setSmall(dir, i_boost);
+        b.setBig(dir, i_boost);
+        slice_bl.push_back(b);
+    }
+    std::unique_ptr<MultiFab> slice(new MultiFab(BoxArray(slice_bl), dm, ncomp, 0));
+
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(*slice, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+        const Box& bx = mfi.tilebox();
+        Array4<      Real> slice_arr = (*slice)[mfi].array();
+        Array4<const Real> slab_arr  = slab[mfi].array();
+        ParallelFor(bx, ncomp,
+            [=] AMREX_GPU_DEVICE (int i, int j, int k, int n)
+            {
+#if (AMREX_SPACEDIM == 3)
+                slice_arr(i,j,k,n) = (1.0-w)*slab_arr(i,j,il,n) + w*slab_arr(i,j,il+1,n);
+#else
+                slice_arr(i,j,k,n) = (1.0-w)*slab_arr(i,il,k,n) + w*slab_arr(i,il+1,k,n);
+#endif
+            }
+        );
+    }
+
+    return slice;
+}
 }
 
 BoostedFrameDiagnostic::
@@ -565,6 +765,11 @@ BoostedFrameDiagnostic(Real zmin_lab, Real zmax_lab, Real v_window_lab,
     bool do_user_fields;
     do_user_fields = pp.queryarr("boosted_frame_diag_fields", 
                                  user_fields_to_dump);
+    pp.query("boosted_frame_diag_async_io", async_io_);
+    Real async_max_mb = 1024.;
+    pp.query("boosted_frame_diag_async_max_mb", async_max_mb);
+    async_max_bytes_ = static_cast<long>(async_max_mb*1024.*1024.);
+    pp.query("boosted_frame_diag_aggregate_particles", aggregate_particles_);
     // If user specifies fields to dump, overwrite ncomp_to_dump, 
     // map_actual_fields_to_dump and mesh_field_names.
 	for (int i = 0; i < 10; ++i) map_actual_fields_to_dump.push_back(i);
@@ -593,6 +798,10 @@ BoostedFrameDiagnostic(Real zmin_lab, Real zmax_lab, Real v_window_lab,
                              mesh_field_names, i, *this);
         snapshots_.push_back(snapshot);
         buff_counter_.push_back(0);
+        if (WarpX::do_boosted_frame_particles) {
+            particle_file_offset_.push_back(
+                Vector<long>(WarpX::GetInstance().GetPartContainer().nSpeciesBoostedFrameDiags(), 0));
+        }
         if (WarpX::do_boosted_frame_fields) data_buffer_[i].reset( nullptr );
     }
 
@@ -660,7 +869,8 @@ void BoostedFrameDiagnostic::Flush(const Geometry& geom)
                     std::stringstream part_ss;
                     part_ss << snapshots_[i].file_name + "/" + species_name + "/";
                     // Dump species data
-                    writeParticleData(particles_buffer_[i][j], part_ss.str(), i_lab);
+                    writeParticleDataAsync(std::move(particles_buffer_[i][j]),
+                                           part_ss.str(), i_lab, i, j);
 #endif
                 }
                 particles_buffer_[i].clear();
@@ -669,6 +879,9 @@ void BoostedFrameDiagnostic::Flush(const Geometry& geom)
         }
     }
 
+    // Wait until all particle buffers are on disk
+    drainIO();
+
     VisMF::SetHeaderVersion(current_version);
 }
 
@@ -689,6 +902,24 @@ writeLabFrameData(const MultiFab* cell_centered_data,
 
     const std::vector<std::string> species_names = mypc.GetSpeciesNames();
 
+    // When no cell-centered data is given, the fields are read directly
+    // from level 0. The charge density only enters jz and rho.
+    std::array<const MultiFab*, 10> src;
+    src.fill(nullptr);
+    std::unique_ptr<MultiFab> rho;
+    bool need_rho = false;
+    if (WarpX::do_boosted_frame_fields and (cell_centered_data == nullptr)) {
+        WarpX& warpx = WarpX::GetInstance();
+        for (int idim = 0; idim < 3; ++idim) {
+            src[idim  ] = &warpx.getEfield(0, idim);
+            src[idim+3] = &warpx.getBfield(0, idim);
+            src[idim+6] = &warpx.getcurrent(0, idim);
+        }
+        for (int n = 0; n < ncomp_to_dump; ++n) {
+            if (map_actual_fields_to_dump[n] >= 8) need_rho = true;
+        }
+    }
+
     // Loop over snapshots
     for (int i = 0; i < N_snapshots_; ++i) {
     
@@ -730,32 +961,45 @@ writeLabFrameData(const MultiFab* cell_centered_data,
         }
 
         if (WarpX::do_boosted_frame_fields) {
-            const int ncomp = cell_centered_data->nComp();
-            const int start_comp = 0;
-            const bool interpolate = true;
-            // Get slice in the boosted frame
-            std::unique_ptr<MultiFab> slice = amrex::get_slice_data(boost_direction_,
-                                                                    snapshots_[i].current_z_boost,
-                                                                    *cell_centered_data, geom,
-                                                                    start_comp, ncomp, interpolate);
-            
-            // transform it to the lab frame
-            LorentzTransformZ(*slice, gamma_boost_, beta_boost_, ncomp);
+            const int ncomp = 10;
             // Create a 2D box for the slice in the boosted frame
             Real dx = geom.CellSize(boost_direction_);
             int i_boost = (snapshots_[i].current_z_boost - geom.ProbLo(boost_direction_))/dx;
-            Box slice_box = geom.Domain();
-            slice_box.setSmall(boost_direction_, i_boost);
-            slice_box.setBig(boost_direction_, i_boost);
-            // Make it a BoxArray slice_ba
-            BoxArray slice_ba(slice_box);
-            slice_ba.maxSize(max_box_size_);
-            // Create MultiFab tmp on slice_ba with data from slice
-            MultiFab tmp(slice_ba, data_buffer_[i]->DistributionMap(), ncomp, 0);
-            tmp.copy(*slice, 0, 0, ncomp);
-            
+            std::unique_ptr<MultiFab> tmp;
+            if (cell_centered_data) {
+                const int start_comp = 0;
+                const bool interpolate = true;
+                // Get slice in the boosted frame
+                std::unique_ptr<MultiFab> slice = amrex::get_slice_data(boost_direction_,
+                                                                        snapshots_[i].current_z_boost,
+                                                                        *cell_centered_data, geom,
+                                                                        start_comp, ncomp, interpolate);
+                Box slice_box = geom.Domain();
+                slice_box.setSmall(boost_direction_, i_boost);
+                slice_box.setBig(boost_direction_, i_boost);
+                // Make it a BoxArray slice_ba
+                BoxArray slice_ba(slice_box);
+                slice_ba.maxSize(max_box_size_);
+                // Create MultiFab tmp on slice_ba with data from slice
+                tmp.reset(new MultiFab(slice_ba, data_buffer_[i]->DistributionMap(), ncomp, 0));
+                tmp->copy(*slice, 0, 0, ncomp);
+            } else {
+                // Only the planes around the snapshot are cell-centered.
+                // The charge density is deposited at most once per call.
+                if (need_rho and (rho == nullptr)) {
+                    rho = WarpX::GetInstance().GetPartContainer().GetChargeDensity(0);
+                    src[9] = rho.get();
+                }
+                tmp = GetCellCenteredSlice(src, geom, boost_direction_,
+                                           snapshots_[i].current_z_boost, i_boost,
+                                           max_box_size_, data_buffer_[i]->DistributionMap());
+            }
+
+            // transform it to the lab frame
+            LorentzTransformZ(*tmp, gamma_boost_, beta_boost_, ncomp);
+
             // Copy data from MultiFab tmp to MultiDab data_buffer[i]
-            CopySlice(tmp, *data_buffer_[i], i_lab, map_actual_fields_to_dump);
+            CopySlice(*tmp, *data_buffer_[i], i_lab, map_actual_fields_to_dump);
         }
 
         if (WarpX::do_boosted_frame_particles) {
@@ -797,8 +1041,9 @@ writeLabFrameData(const MultiFab* cell_centered_data,
 
                     part_ss << snapshots_[i].file_name + "/" + species_name + "/";
 
-                    // Write data to disk (custom)
-                    writeParticleData(particles_buffer_[i][j], part_ss.str(), i_lab);
+                    // Write data to disk (custom), in the background
+                    writeParticleDataAsync(std::move(particles_buffer_[i][j]),
+                                           part_ss.str(), i_lab, i, j);
 #endif
                 }            
                 particles_buffer_[i].clear();
@@ -859,53 +1104,128 @@ writeParticleDataHDF5(const WarpXParticleContainer::DiagnosticParticleData& pdat
 
 void
 BoostedFrameDiagnostic::
-writeParticleData(const WarpXParticleContainer::DiagnosticParticleData& pdata,
-                  const std::string& name, const int i_lab)
+writeParticleRequest (const ParticleWriteRequest& req)
+{
+    if (req.aggregate) {
+        WriteParticleBlock(req.pdata, req.name, req.file_offset,
+                           req.total_np, req.rank_offset);
+    } else {
+        WriteParticleFiles(req.pdata, req.name, req.i_lab, req.proc);
+    }
+}
+
+void
+BoostedFrameDiagnostic::
+writeParticleDataAsync(WarpXParticleContainer::DiagnosticParticleData&& pdata,
+                       const std::string& name, const int i_lab,
+                       const int i_snapshot, const int i_species)
 {
     BL_PROFILE("BoostedFrameDiagnostic::writeParticleData");
-    
-    std::string field_name;
-    std::ofstream ofs;
 
+    const long np = pdata.GetRealData(DiagIdx::w).size();
     const int MyProc = ParallelDescriptor::MyProc();
-    auto np = pdata.GetRealData(DiagIdx::w).size();
 
-    if (np == 0) return;
+    ParticleWriteRequest req;
+    req.name = name;
+    req.i_lab = i_lab;
+    req.proc = MyProc;
+    req.aggregate = aggregate_particles_;
+    req.nbytes = np * DiagIdx::nattribs * sizeof(Real);
+
+    if (aggregate_particles_) {
+        // Reserve one block of the aggregated file for this flush, and
+        // find the slot of this rank in it.
+        const int nprocs = ParallelDescriptor::NProcs();
+        Vector<long> particle_counts(nprocs, 0);
+        ParallelAllGather::AllGather(np, particle_counts.data(),
+                                     ParallelContext::CommunicatorAll());
+        long total_np = 0;
+        for (int p = 0; p < nprocs; ++p) {
+            if (p == MyProc) req.rank_offset = total_np;
+            total_np += particle_counts[p];
+        }
+        if (total_np == 0) return;
 
-    field_name = name + Concatenate("w_", i_lab, 5) + "_" + std::to_string(MyProc);
-    ofs.open(field_name.c_str(), std::ios::out|std::ios::binary);
-    writeRealData(pdata.GetRealData(DiagIdx::w).data(), np, ofs);
-    ofs.close();
+        req.name = name + "particles";
+        req.total_np = total_np;
+        req.file_offset = particle_file_offset_[i_snapshot][i_species];
+        particle_file_offset_[i_snapshot][i_species] +=
+            total_np * DiagIdx::nattribs * sizeof(Real);
 
-    field_name = name + Concatenate("x_", i_lab, 5) + "_" + std::to_string(MyProc);
-    ofs.open(field_name.c_str(), std::ios::out|std::ios::binary);
-    writeRealData(pdata.GetRealData(DiagIdx::x).data(), np, ofs);
-    ofs.close();    
+        if (ParallelDescriptor::IOProcessor()) {
+            std::ofstream index_file(name + "particles_index", std::ios::app);
+            index_file << i_lab << ' ' << req.file_offset << ' ' << total_np << '\n';
+        }
+    }
 
-    field_name = name + Concatenate("y_", i_lab, 5) + "_" + std::to_string(MyProc);
-    ofs.open(field_name.c_str(), std::ios::out|std::ios::binary);
-    writeRealData(pdata.GetRealData(DiagIdx::y).data(), np, ofs);
-    ofs.close();    
+    if (np == 0) return;
+    req.pdata = std::move(pdata);
 
-    field_name = name + Concatenate("z_", i_lab, 5) + "_" + std::to_string(MyProc);
-    ofs.open(field_name.c_str(), std::ios::out|std::ios::binary);
-    writeRealData(pdata.GetRealData(DiagIdx::z).data(), np, ofs);
-    ofs.close();    
-    
-    field_name = name + Concatenate("ux_", i_lab, 5) + "_" + std::to_string(MyProc);
-    ofs.open(field_name.c_str(), std::ios::out|std::ios::binary);
-    writeRealData(pdata.GetRealData(DiagIdx::ux).data(), np, ofs);
-    ofs.close();    
+    if (not async_io_) {
+        writeParticleRequest(req);
+        return;
+    }
 
-    field_name = name + Concatenate("uy_", i_lab, 5) + "_" + std::to_string(MyProc);
-    ofs.open(field_name.c_str(), std::ios::out|std::ios::binary);
-    writeRealData(pdata.GetRealData(DiagIdx::uy).data(), np, ofs);
-    ofs.close();    
+    const long nbytes = req.nbytes;
+    std::unique_lock<std::mutex> lock(io_mutex_);
+    if (not io_thread_.joinable()) {
+        io_thread_ = std::thread(&BoostedFrameDiagnostic::ioThreadLoop, this);
+    }
+    // Wait for the previous buffers to drain if the new one does not fit
+    // in the memory budget. A buffer larger than the budget is still
+    // written, once the queue is empty.
+    io_cv_.wait(lock, [this, nbytes]{
+        return (io_pending_bytes_ == 0) or
+               (io_pending_bytes_ + nbytes <= async_max_bytes_); });
+    io_pending_bytes_ += nbytes;
+    io_queue_.push_back(std::move(req));
+    lock.unlock();
+    io_cv_.notify_all();
+}
 
-    field_name = name + Concatenate("uz_", i_lab, 5) + "_" + std::to_string(MyProc);
-    ofs.open(field_name.c_str(), std::ios::out|std::ios::binary);
-    writeRealData(pdata.GetRealData(DiagIdx::uz).data(), np, ofs);
-    ofs.close();
+void
+BoostedFrameDiagnostic::
+ioThreadLoop ()
+{
+    while (true) {
+        ParticleWriteRequest req;
+        {
+            std::unique_lock<std::mutex> lock(io_mutex_);
+            io_cv_.wait(lock, [this]{ return io_stop_ or (not io_queue_.empty()); });
+            // Only stop once all pending buffers are written
+            if (io_queue_.empty()) return;
+            req = std::move(io_queue_.front());
+            io_queue_.pop_front();
+        }
+        writeParticleRequest(req);
+        {
+            std::lock_guard<std::mutex> lock(io_mutex_);
+            io_pending_bytes_ -= req.nbytes;
+        }
+        io_cv_.notify_all();
+    }
+}
+
+void
+BoostedFrameDiagnostic::
+drainIO ()
+{
+    BL_PROFILE("BoostedFrameDiagnostic::drainIO");
+    std::unique_lock<std::mutex> lock(io_mutex_);
+    io_cv_.wait(lock, [this]{ return io_pending_bytes_ == 0; });
+}
+
+BoostedFrameDiagnostic::
+~BoostedFrameDiagnostic ()
+{
+    if (io_thread_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(io_mutex_);
+            io_stop_ = true;
+        }
+        io_cv_.notify_all();
+        io_thread_.join();
+    }
 }
 
 void
@@ -1029,6 +1349,17 @@ LabSnapShot(Real t_lab_in, Real t_boost, RealBox prob_domain_lab,
             const std::string fullpath = file_name + "/" + species_name;
             if (!UtilCreateDirectory(fullpath, 0755))
                 CreateDirectoryFailed(fullpath);
+            if (my_bfd.aggregate_particles_) {
+                // Empty particle file, and index of its blocks
+                std::ofstream particle_file(fullpath + "/particles",
+                                            std::ios::out|std::ios::trunc|std::ios::binary);
+                std::ofstream index_file(fullpath + "/particles_index",
+                                         std::ios::out|std::ios::trunc);
+                for (const auto& name : {"w", "x", "y", "z", "ux", "uy", "uz"}) {
+                    index_file << name << ' ';
+                }
+                index_file << '\n' << sizeof(Real) << '\n';
+            }
         }
     }
 #endif
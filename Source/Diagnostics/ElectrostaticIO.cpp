@@ -45,8 +45,8 @@ WritePlotFileES (const amrex::Vector<std::unique_ptr<amrex::MultiFab> >& rho,
             dcomp += 1;
 
             amrex::average_node_to_cellcenter(*mf[lev], dcomp  , *E[lev][0], 0, 1);
-            amrex::average_node_to_cellcenter(*mf[lev], dcomp+1, *E[lev][0], 0, 1);
-            amrex::average_node_to_cellcenter(*mf[lev], dcomp+2, *E[lev][0], 0, 1);
+            amrex::average_node_to_cellcenter(*mf[lev], dcomp+1, *E[lev][1], 0, 1);
+            amrex::average_node_to_cellcenter(*mf[lev], dcomp+2, *E[lev][2], 0, 1);
 
             if (lev == 0) {
                 varnames.push_back("Ex");
@@ -98,24 +98,8 @@ WritePlotFileES (const amrex::Vector<std::unique_ptr<amrex::MultiFab> >& rho,
         }
     }
 
-    Vector<std::string> particle_varnames;
-    particle_varnames.push_back("weight");
-
-    particle_varnames.push_back("momentum_x");
-    particle_varnames.push_back("momentum_y");
-    particle_varnames.push_back("momentum_z");
-
-    particle_varnames.push_back("Ex");
-    particle_varnames.push_back("Ey");
-    particle_varnames.push_back("Ez");
-
-    particle_varnames.push_back("Bx");
-    particle_varnames.push_back("By");
-    particle_varnames.push_back("Bz");
-
-    Vector<std::string> int_names;
-        
-    mypc->Checkpoint(plotfilename, particle_varnames, int_names);
+    // Binary particle output, with the same attributes as in EvolveEM
+    mypc->WritePlotFile(plotfilename);
 
     WriteJobInfo(plotfilename);
 
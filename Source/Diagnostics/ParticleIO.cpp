@@ -90,14 +90,6 @@ MultiParticleContainer::WritePlotFile (const std::string& dir) const
             real_names.push_back("momentum_y");
             real_names.push_back("momentum_z");
             
-            real_names.push_back("Ex");
-            real_names.push_back("Ey");
-            real_names.push_back("Ez");
-            
-            real_names.push_back("Bx");
-            real_names.push_back("By");
-            real_names.push_back("Bz");
-            
 #ifdef WARPX_DIM_RZ
             real_names.push_back("theta");
 #endif
@@ -112,6 +104,13 @@ MultiParticleContainer::WritePlotFile (const std::string& dir) const
                 real_names.push_back("uyold");
                 real_names.push_back("uzold");
             }
+
+            if (pc->SaveFieldsOnParticles())
+            {
+                for (const auto& name : ParticleStringNames::field_names) {
+                    real_names.push_back(name);
+                }
+            }
                         
             // Convert momentum to SI
             pc->ConvertUnits(ConvertDirection::WarpX_to_SI);
@@ -36,6 +36,9 @@ WarpX::EvolveEM (int numsteps)
         numsteps_max = std::min(istep[0]+numsteps, max_step);
     }
 
+    // E and B may have been modified since the last call (e.g. from Python)
+    eb_guards_filled = false;
+
     bool max_time_reached = false;
     Real walltime, walltime_start = amrex::second();
     for (int step = istep[0]; step < numsteps_max && cur_time < stop_time; ++step)
@@ -45,7 +48,10 @@ WarpX::EvolveEM (int numsteps)
         // Start loop on time steps
         amrex::Print() << "\nSTEP " << step+1 << " starts ...\n";
 #ifdef WARPX_USE_PY
-        if (warpx_py_beforestep) warpx_py_beforestep();
+        if (warpx_py_beforestep) {
+            warpx_py_beforestep();
+            eb_guards_filled = false;
+        }
 #endif
 
         if (costs[0] != nullptr)
@@ -57,6 +63,7 @@ WarpX::EvolveEM (int numsteps)
             if (step > 0 && (step+1) % load_balance_int == 0)
             {
                 LoadBalance();
+                eb_guards_filled = false;
                 // Reset the costs to 0
                 for (int lev = 0; lev <= finest_level; ++lev) {
                     costs[lev]->setVal(0.0);
@@ -88,11 +95,21 @@ WarpX::EvolveEM (int numsteps)
         } else {
             // Beyond one step, we have E^{n} and B^{n}.
             // Particles have p^{n-1/2} and x^{n}.
-            FillBoundaryE();
-            FillBoundaryB();
+            if (eb_guards_filled) {
+                // The communication-avoiding update already exchanged
+                // the guard cells of E and B at the end of the last step
+            } else if (overlap_fillboundary_push) {
+                // Completed in PushParticlesandDepose, once the
+                // interior particles have been pushed
+                FillBoundaryEB_nowait();
+            } else {
+                FillBoundaryE();
+                FillBoundaryB();
+            }
             UpdateAuxilaryData();
 
         }
+        eb_guards_filled = false;
 
         if (do_subcycling == 0 || finest_level == 0) {
             OneStep_nosub(cur_time);
@@ -105,10 +122,14 @@ WarpX::EvolveEM (int numsteps)
 
         if (num_mirrors>0){
             applyMirrors(cur_time);
+            eb_guards_filled = false;
         }
 
 #ifdef WARPX_USE_PY
-        if (warpx_py_beforeEsolve) warpx_py_beforeEsolve();
+        if (warpx_py_beforeEsolve) {
+            warpx_py_beforeEsolve();
+            eb_guards_filled = false;
+        }
 #endif
         if (cur_time + dt[0] >= stop_time - 1.e-3*dt[0] || step == numsteps_max-1) {
             // At the end of last step, push p by 0.5*dt to synchronize
@@ -123,7 +144,10 @@ WarpX::EvolveEM (int numsteps)
             is_synchronized = true;
         }
 #ifdef WARPX_USE_PY
-        if (warpx_py_afterEsolve) warpx_py_afterEsolve();
+        if (warpx_py_afterEsolve) {
+            warpx_py_afterEsolve();
+            eb_guards_filled = false;
+        }
 #endif
 
         for (int lev = 0; lev <= max_level; ++lev) {
@@ -145,6 +169,7 @@ WarpX::EvolveEM (int numsteps)
         // We might need to move j because we are going to make a plotfile.
 
         int num_moved = MoveWindow(move_j);
+        if (num_moved != 0) eb_guards_filled = false;
         
         if (max_level == 0) {
             int num_redistribute_ghost = num_moved + 1;
@@ -155,7 +180,14 @@ WarpX::EvolveEM (int numsteps)
         }
 
         bool to_sort = (sort_int > 0) && ((step+1) % sort_int == 0);
-        if (to_sort) {
+        if (sort_incremental) {
+            // Every sort_int steps, or every step if sort_int is not set.
+            // The interior particles are kept first if they are partitioned
+            // by PushParticlesandDepose.
+            if (sort_int <= 0 || to_sort) {
+                mypc->SortParticlesByBin(sort_bin_size, overlap_fillboundary_push);
+            }
+        } else if (to_sort) {
             amrex::Print() << "re-sorting particles \n";
             mypc->SortParticlesByCell();
         }
@@ -174,8 +206,11 @@ WarpX::EvolveEM (int numsteps)
         }
 
         if (do_boosted_frame_diagnostic) {
+            // With a single level, the back-transformed diagnostics
+            // cell-center only the planes they need. With mesh refinement,
+            // the finer levels are first averaged down over the whole domain.
             std::unique_ptr<MultiFab> cell_centered_data = nullptr;
-            if (WarpX::do_boosted_frame_fields) {
+            if (WarpX::do_boosted_frame_fields and finest_level > 0) {
                 cell_centered_data = GetCellCenteredData();
             }
             myBFD->writeLabFrameData(cell_centered_data.get(), *mypc, geom[0], cur_time, dt[0]);
@@ -291,22 +326,46 @@ WarpX::OneStep_nosub (Real cur_time)
     if (warpx_py_afterdeposition) warpx_py_afterdeposition();
 #endif
 
-    SyncCurrent();
+    if (overlap_sumboundary_j) {
+        // Completed right before J is used
+        SyncCurrent_nowait();
+    } else {
+        SyncCurrent();
+    }
 
     SyncRho();
 
     // Push E and B from {n} to {n+1}
     // (And update guard cells immediately afterwards)
 #ifdef WARPX_USE_PSATD
+    SyncCurrent_finish();
     PushPSATD(dt[0]);
     if (do_pml) DampPML();
     FillBoundaryE();
     FillBoundaryB();
 #else
+    if (do_comm_avoiding_fdtd) {
+        // Communication-avoiding update: B and E are also advanced in
+        // the guard cells that the next sub-update reads, so that
+        // the intermediate exchanges are replaced by redundant local work.
+        // (Only J, after its guard cells are summed, and the final
+        // E and B need to be exchanged.)
+        SyncCurrent_finish();
+        FillBoundaryJ();
+        for (int lev = 0; lev <= finest_level; ++lev) {
+            EvolveB(lev, PatchType::fine, 0.5*dt[lev], 2);
+            EvolveE(lev, PatchType::fine, dt[lev], 1);
+            EvolveB(lev, PatchType::fine, 0.5*dt[lev], 0);
+        }
+        FillBoundaryEB();
+        eb_guards_filled = true;
+        return;
+    }
     EvolveF(0.5*dt[0], DtType::FirstHalf);
     FillBoundaryF();
     EvolveB(0.5*dt[0]); // We now have B^{n+1/2}
     FillBoundaryB();
+    SyncCurrent_finish();
     EvolveE(dt[0]); // We now have E^{n+1}
     FillBoundaryE();
     EvolveF(0.5*dt[0], DtType::SecondHalf);
@@ -473,15 +532,27 @@ WarpX::PushParticlesandDepose (Real cur_time)
 void
 WarpX::PushParticlesandDepose (int lev, Real cur_time)
 {
-    mypc->Evolve(lev,
-                 *Efield_aux[lev][0],*Efield_aux[lev][1],*Efield_aux[lev][2],
-                 *Bfield_aux[lev][0],*Bfield_aux[lev][1],*Bfield_aux[lev][2],
-                 *current_fp[lev][0],*current_fp[lev][1],*current_fp[lev][2],
-                 current_buf[lev][0].get(), current_buf[lev][1].get(), current_buf[lev][2].get(),
-                 rho_fp[lev].get(), charge_buf[lev].get(),
-                 Efield_cax[lev][0].get(), Efield_cax[lev][1].get(), Efield_cax[lev][2].get(),
-                 Bfield_cax[lev][0].get(), Bfield_cax[lev][1].get(), Bfield_cax[lev][2].get(),
-                 cur_time, dt[lev]);
+    auto evolve = [&] (EvolveRegion region) {
+        mypc->Evolve(lev,
+                     *Efield_aux[lev][0],*Efield_aux[lev][1],*Efield_aux[lev][2],
+                     *Bfield_aux[lev][0],*Bfield_aux[lev][1],*Bfield_aux[lev][2],
+                     *current_fp[lev][0],*current_fp[lev][1],*current_fp[lev][2],
+                     current_buf[lev][0].get(), current_buf[lev][1].get(), current_buf[lev][2].get(),
+                     rho_fp[lev].get(), charge_buf[lev].get(),
+                     Efield_cax[lev][0].get(), Efield_cax[lev][1].get(), Efield_cax[lev][2].get(),
+                     Bfield_cax[lev][0].get(), Bfield_cax[lev][1].get(), Bfield_cax[lev][2].get(),
+                     cur_time, dt[lev], region);
+    };
+    if (eb_exchange_in_flight) {
+        // The particles far enough from the box boundaries only gather
+        // the fields in the valid cells: push them while the guard cells
+        // of E and B are exchanged, then push the remaining particles.
+        evolve(EvolveRegion::Interior);
+        FillBoundaryEB_finish();
+        evolve(EvolveRegion::Boundary);
+    } else {
+        evolve(EvolveRegion::All);
+    }
 #ifdef WARPX_DIM_RZ
     // This is called after all particles have deposited their current and charge.
     ApplyInverseVolumeScalingToCurrentDensity(current_fp[lev][0].get(), current_fp[lev][1].get(), current_fp[lev][2].get(), lev);
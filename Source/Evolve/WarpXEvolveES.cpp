@@ -82,9 +82,13 @@ WarpX::EvolveES (int numsteps) {
 
         mypc->FieldGatherES(eFieldNodal, gather_masks);
 
-        const std::string& ppltfile = amrex::Concatenate("particles", istep[0], 5);
-        auto& pc = mypc->GetParticleContainer(0);
-        pc.WriteAsciiFile(ppltfile);
+        // Particles are written in binary with the plotfiles. The ASCII dump
+        // is only meant for debugging small runs.
+        if (es_ascii_particle_int > 0 && istep[0] % es_ascii_particle_int == 0) {
+            const std::string& ppltfile = amrex::Concatenate("particles", istep[0], 5);
+            auto& pc = mypc->GetParticleContainer(0);
+            pc.WriteAsciiFile(ppltfile);
+        }
 
         // Evolve particles to p^{n+1/2} and x^{n+1}
         mypc->EvolveES(eFieldNodal, rhoNodal, cur_time, dt[lev]);
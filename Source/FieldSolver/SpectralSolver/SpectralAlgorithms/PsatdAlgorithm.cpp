@@ -1,9 +1,36 @@
 #include <PsatdAlgorithm.H>
 #include <WarpXConst.H>
+#include <AMReX_ParmParse.H>
 #include <cmath>
 
 using namespace amrex;
 
+namespace {
+    /* \brief Compute the coefficients of the PSATD update equation,
+     * for a given norm of the modified k vector */
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    void computePsatdCoefficients (const Real k_norm, const Real dt,
+                                   Real& C, Real& S_ck,
+                                   Real& X1, Real& X2, Real& X3)
+    {
+        constexpr Real c = PhysConst::c;
+        constexpr Real ep0 = PhysConst::ep0;
+        if (k_norm != 0){
+            C = std::cos(c*k_norm*dt);
+            S_ck = std::sin(c*k_norm*dt)/(c*k_norm);
+            X1 = (1. - C)/(ep0 * c*c * k_norm*k_norm);
+            X2 = (1. - S_ck/dt)/(ep0 * k_norm*k_norm);
+            X3 = (C - S_ck/dt)/(ep0 * k_norm*k_norm);
+        } else { // Handle k_norm = 0, by using the analytical limit
+            C = 1.;
+            S_ck = dt;
+            X1 = 0.5 * dt*dt / ep0;
+            X2 = c*c * dt*dt / (6.*ep0);
+            X3 = - c*c * dt*dt / (3.*ep0);
+        }
+    }
+}
+
 /* \brief Initialize coefficients for the update equation */
 PsatdAlgorithm::PsatdAlgorithm(const SpectralKSpace& spectral_kspace,
                          const DistributionMapping& dm,
@@ -14,6 +41,12 @@ PsatdAlgorithm::PsatdAlgorithm(const SpectralKSpace& spectral_kspace,
                               norder_x, norder_y, norder_z, nodal )
 {
     const BoxArray& ba = spectral_kspace.spectralspace_ba;
+    m_dt = dt;
+
+    ParmParse pp("psatd");
+    pp.query("low_memory", low_memory);
+    // In low-memory mode, the coefficients are computed on the fly
+    if (low_memory) return;
 
     // Allocate the arrays of coefficients
     C_coef = SpectralCoefficients(ba, dm, 1, 0);
@@ -30,6 +63,9 @@ PsatdAlgorithm::PsatdAlgorithm(const SpectralKSpace& spectral_kspace,
 void
 PsatdAlgorithm::pushSpectralFields(SpectralFieldData& f) const{
 
+    const bool compute_coefs = low_memory;
+    const Real dt = m_dt;
+
     // Loop over boxes
     for (MFIter mfi(f.fields); mfi.isValid(); ++mfi){
 
@@ -37,12 +73,16 @@ PsatdAlgorithm::pushSpectralFields(SpectralFieldData& f) const{
 
         // Extract arrays for the fields to be updated
         Array4<Complex> fields = f.fields[mfi].array();
-        // Extract arrays for the coefficients
-        Array4<const Real> C_arr = C_coef[mfi].array();
-        Array4<const Real> S_ck_arr = S_ck_coef[mfi].array();
-        Array4<const Real> X1_arr = X1_coef[mfi].array();
-        Array4<const Real> X2_arr = X2_coef[mfi].array();
-        Array4<const Real> X3_arr = X3_coef[mfi].array();
+        // Extract arrays for the coefficients (unless they are computed
+        // on the fly, in which case they are not allocated)
+        Array4<const Real> C_arr, S_ck_arr, X1_arr, X2_arr, X3_arr;
+        if (!compute_coefs) {
+            C_arr = C_coef[mfi].array();
+            S_ck_arr = S_ck_coef[mfi].array();
+            X1_arr = X1_coef[mfi].array();
+            X2_arr = X2_coef[mfi].array();
+            X3_arr = X3_coef[mfi].array();
+        }
         // Extract pointers for the k vectors
         const Real* modified_kx_arr = modified_kx_vec[mfi].dataPtr();
 #if (AMREX_SPACEDIM==3)
@@ -80,11 +120,19 @@ PsatdAlgorithm::pushSpectralFields(SpectralFieldData& f) const{
             constexpr Real c2 = PhysConst::c*PhysConst::c;
             constexpr Real inv_ep0 = 1./PhysConst::ep0;
             const Complex I = Complex{0,1};
-            const Real C = C_arr(i,j,k);
-            const Real S_ck = S_ck_arr(i,j,k);
-            const Real X1 = X1_arr(i,j,k);
-            const Real X2 = X2_arr(i,j,k);
-            const Real X3 = X3_arr(i,j,k);
+            Real C, S_ck, X1, X2, X3;
+            if (compute_coefs) {
+                // Trade memory bandwidth for computation: a few
+                // transcendental functions instead of five loads
+                const Real k_norm = std::sqrt(kx*kx + ky*ky + kz*kz);
+                computePsatdCoefficients(k_norm, dt, C, S_ck, X1, X2, X3);
+            } else {
+                C = C_arr(i,j,k);
+                S_ck = S_ck_arr(i,j,k);
+                X1 = X1_arr(i,j,k);
+                X2 = X2_arr(i,j,k);
+                X3 = X3_arr(i,j,k);
+            }
 
 
             // Update E (see WarpX online documentation: theory section)
@@ -152,21 +200,8 @@ void PsatdAlgorithm::InitializeSpectralCoefficients(const SpectralKSpace& spectr
 
 
             // Calculate coefficients
-            constexpr Real c = PhysConst::c;
-            constexpr Real ep0 = PhysConst::ep0;
-            if (k_norm != 0){
-                C(i,j,k) = std::cos(c*k_norm*dt);
-                S_ck(i,j,k) = std::sin(c*k_norm*dt)/(c*k_norm);
-                X1(i,j,k) = (1. - C(i,j,k))/(ep0 * c*c * k_norm*k_norm);
-                X2(i,j,k) = (1. - S_ck(i,j,k)/dt)/(ep0 * k_norm*k_norm);
-                X3(i,j,k) = (C(i,j,k) - S_ck(i,j,k)/dt)/(ep0 * k_norm*k_norm);
-            } else { // Handle k_norm = 0, by using the analytical limit
-                C(i,j,k) = 1.;
-                S_ck(i,j,k) = dt;
-                X1(i,j,k) = 0.5 * dt*dt / ep0;
-                X2(i,j,k) = c*c * dt*dt / (6.*ep0);
-                X3(i,j,k) = - c*c * dt*dt / (3.*ep0);
-            }
+            computePsatdCoefficients(k_norm, dt, C(i,j,k), S_ck(i,j,k),
+                                     X1(i,j,k), X2(i,j,k), X3(i,j,k));
         });
      }
 }
@@ -1,7 +1,67 @@
 #include <SpectralFieldData.H>
 
+#include <AMReX_ParmParse.H>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <cstdio>
+
 using namespace amrex;
 
+#ifndef AMREX_USE_GPU
+namespace {
+
+    std::string fftw_wisdom_file;
+
+    /* \brief Prepare FFTW for creating plans: enable threads, load the
+     * wisdom file (once per run) and return the planner flags, based on
+     * `psatd.fftw_plan_measure` */
+    unsigned InitFFTWPlanner ()
+    {
+        static bool initialized = false;
+        int fftw_plan_measure = 1;
+        ParmParse pp("psatd");
+        pp.query("fftw_plan_measure", fftw_plan_measure);
+        if (!initialized) {
+#ifdef _OPENMP
+            fftw_init_threads();
+#endif
+            pp.query("fftw_wisdom_file", fftw_wisdom_file);
+            if (!fftw_wisdom_file.empty()) {
+                // A missing or unreadable file is not an error:
+                // the plans are simply computed from scratch
+                fftw_import_wisdom_from_filename(fftw_wisdom_file.c_str());
+            }
+            initialized = true;
+        }
+#ifdef _OPENMP
+        // The loops over boxes in SpectralFieldData are not threaded,
+        // so each FFT uses all the available threads
+        fftw_plan_with_nthreads(omp_get_max_threads());
+#endif
+        return fftw_plan_measure ? FFTW_MEASURE : FFTW_ESTIMATE;
+    }
+
+    /* \brief Save the accumulated FFTW wisdom, so that the plans
+     * of subsequent runs can be created without measuring again */
+    void SaveFFTWWisdom ()
+    {
+        if (fftw_wisdom_file.empty() || !ParallelDescriptor::IOProcessor()) return;
+        // Write to a temporary file first, so that the other ranks
+        // never import a partially-written file
+        const std::string tmp_file = fftw_wisdom_file + ".tmp";
+        if (fftw_export_wisdom_to_filename(tmp_file.c_str())) {
+            std::rename(tmp_file.c_str(), fftw_wisdom_file.c_str());
+        } else {
+            amrex::Warning("Could not write FFTW wisdom file " + fftw_wisdom_file);
+        }
+    }
+}
+#endif
+
 /* \brief Initialize fields in spectral space, and FFT plans */
 SpectralFieldData::SpectralFieldData( const BoxArray& realspace_ba,
                             const SpectralKSpace& k_space,
@@ -16,8 +76,10 @@ SpectralFieldData::SpectralFieldData( const BoxArray& realspace_ba,
 
     // Allocate temporary arrays - in real space and spectral space
     // These arrays will store the data just before/after the FFT
-    tmpRealField = MultiFab(realspace_ba, dm, 1, 0);
-    tmpSpectralField = SpectralField(spectralspace_ba, dm, 1, 0);
+    // (with n_batch components, so that several fields can be transformed
+    // by a single batched FFT)
+    tmpRealField = MultiFab(realspace_ba, dm, n_batch, 0);
+    tmpSpectralField = SpectralField(spectralspace_ba, dm, n_batch, 0);
 
     // By default, we assume the FFT is done from/to a nodal grid in real space
     // It the FFT is performed from/to a cell-centered grid in real space,
@@ -45,6 +107,11 @@ SpectralFieldData::SpectralFieldData( const BoxArray& realspace_ba,
     // Allocate and initialize the FFT plans
     forward_plan = FFTplans(spectralspace_ba, dm);
     backward_plan = FFTplans(spectralspace_ba, dm);
+    forward_plan_batch = FFTplans(spectralspace_ba, dm);
+    backward_plan_batch = FFTplans(spectralspace_ba, dm);
+#ifndef AMREX_USE_GPU
+    const unsigned fftw_flags = InitFFTWPlanner();
+#endif
     // Loop over boxes and allocate the corresponding plan
     // for each box owned by the local MPI proc
     for ( MFIter mfi(spectralspace_ba, dm); mfi.isValid(); ++mfi ){
@@ -52,63 +119,69 @@ SpectralFieldData::SpectralFieldData( const BoxArray& realspace_ba,
         // differ when using real-to-complex FFT. When initializing
         // the FFT plan, the valid dimensions are those of the real-space box.
         IntVect fft_size = realspace_ba[mfi].length();
+        // Swap dimensions: AMReX FAB are Fortran-order but FFT libraries
+        // are C-order
+#if (AMREX_SPACEDIM == 3)
+        int n[AMREX_SPACEDIM] = {fft_size[2], fft_size[1], fft_size[0]};
+#else
+        int n[AMREX_SPACEDIM] = {fft_size[1], fft_size[0]};
+#endif
+        // Distance between consecutive components, for the batched plans
+        const int real_dist = tmpRealField[mfi].box().numPts();
+        const int spectral_dist = tmpSpectralField[mfi].box().numPts();
 #ifdef AMREX_USE_GPU
         // Create cuFFT plans
-        // Creating 3D plan for real to complex -- double precision
+        // Creating plans for real to complex -- double precision
         // Assuming CUDA is used for programming GPU
         // Note that D2Z is inherently forward plan
         // and  Z2D is inherently backward plan
         cufftResult result;
-#if (AMREX_SPACEDIM == 3)
-        result = cufftPlan3d( &forward_plan[mfi], fft_size[2],
-                              fft_size[1],fft_size[0], CUFFT_D2Z);
+        result = cufftPlanMany( &forward_plan[mfi], AMREX_SPACEDIM, n,
+                                nullptr, 1, real_dist, nullptr, 1, spectral_dist,
+                                CUFFT_D2Z, 1 );
         if ( result != CUFFT_SUCCESS ) {
-           amrex::Print() << " cufftplan3d forward failed! \n";
+           amrex::Print() << " cufftPlanMany forward failed! \n";
         }
-
-        result = cufftPlan3d( &backward_plan[mfi], fft_size[2],
-                              fft_size[1], fft_size[0], CUFFT_Z2D);
+        result = cufftPlanMany( &backward_plan[mfi], AMREX_SPACEDIM, n,
+                                nullptr, 1, spectral_dist, nullptr, 1, real_dist,
+                                CUFFT_Z2D, 1 );
         if ( result != CUFFT_SUCCESS ) {
-           amrex::Print() << " cufftplan3d backward failed! \n";
+           amrex::Print() << " cufftPlanMany backward failed! \n";
         }
-#else
-        result = cufftPlan2d( &forward_plan[mfi], fft_size[1],
-                              fft_size[0], CUFFT_D2Z );
+        result = cufftPlanMany( &forward_plan_batch[mfi], AMREX_SPACEDIM, n,
+                                nullptr, 1, real_dist, nullptr, 1, spectral_dist,
+                                CUFFT_D2Z, n_batch );
         if ( result != CUFFT_SUCCESS ) {
-           amrex::Print() << " cufftplan2d forward failed! \n";
+           amrex::Print() << " cufftPlanMany batched forward failed! \n";
         }
-
-        result = cufftPlan2d( &backward_plan[mfi], fft_size[1],
-                               fft_size[0], CUFFT_Z2D );
+        result = cufftPlanMany( &backward_plan_batch[mfi], AMREX_SPACEDIM, n,
+                                nullptr, 1, spectral_dist, nullptr, 1, real_dist,
+                                CUFFT_Z2D, n_batch );
         if ( result != CUFFT_SUCCESS ) {
-           amrex::Print() << " cufftplan2d backward failed! \n";
+           amrex::Print() << " cufftPlanMany batched backward failed! \n";
         }
-#endif
-
 #else
         // Create FFTW plans
-        forward_plan[mfi] =
-            // Swap dimensions: AMReX FAB are Fortran-order but FFTW is C-order
-#if (AMREX_SPACEDIM == 3)
-            fftw_plan_dft_r2c_3d( fft_size[2], fft_size[1], fft_size[0],
-#else
-            fftw_plan_dft_r2c_2d( fft_size[1], fft_size[0],
-#endif
-            tmpRealField[mfi].dataPtr(),
-            reinterpret_cast<fftw_complex*>( tmpSpectralField[mfi].dataPtr() ),
-            FFTW_ESTIMATE );
-        backward_plan[mfi] =
-            // Swap dimensions: AMReX FAB are Fortran-order but FFTW is C-order
-#if (AMREX_SPACEDIM == 3)
-            fftw_plan_dft_c2r_3d( fft_size[2], fft_size[1], fft_size[0],
-#else
-            fftw_plan_dft_c2r_2d( fft_size[1], fft_size[0],
-#endif
-            reinterpret_cast<fftw_complex*>( tmpSpectralField[mfi].dataPtr() ),
-            tmpRealField[mfi].dataPtr(),
-            FFTW_ESTIMATE );
+        Real* real_ptr = tmpRealField[mfi].dataPtr();
+        fftw_complex* spectral_ptr =
+            reinterpret_cast<fftw_complex*>( tmpSpectralField[mfi].dataPtr() );
+        forward_plan[mfi] = fftw_plan_many_dft_r2c( AMREX_SPACEDIM, n, 1,
+            real_ptr, nullptr, 1, real_dist,
+            spectral_ptr, nullptr, 1, spectral_dist, fftw_flags );
+        backward_plan[mfi] = fftw_plan_many_dft_c2r( AMREX_SPACEDIM, n, 1,
+            spectral_ptr, nullptr, 1, spectral_dist,
+            real_ptr, nullptr, 1, real_dist, fftw_flags );
+        forward_plan_batch[mfi] = fftw_plan_many_dft_r2c( AMREX_SPACEDIM, n, n_batch,
+            real_ptr, nullptr, 1, real_dist,
+            spectral_ptr, nullptr, 1, spectral_dist, fftw_flags );
+        backward_plan_batch[mfi] = fftw_plan_many_dft_c2r( AMREX_SPACEDIM, n, n_batch,
+            spectral_ptr, nullptr, 1, spectral_dist,
+            real_ptr, nullptr, 1, real_dist, fftw_flags );
 #endif
     }
+#ifndef AMREX_USE_GPU
+    SaveFFTWWisdom();
+#endif
 }
 
 
@@ -120,15 +193,20 @@ SpectralFieldData::~SpectralFieldData()
             // Destroy cuFFT plans
             cufftDestroy( forward_plan[mfi] );
             cufftDestroy( backward_plan[mfi] );
+            cufftDestroy( forward_plan_batch[mfi] );
+            cufftDestroy( backward_plan_batch[mfi] );
 #else
             // Destroy FFTW plans
             fftw_destroy_plan( forward_plan[mfi] );
             fftw_destroy_plan( backward_plan[mfi] );
+            fftw_destroy_plan( forward_plan_batch[mfi] );
+            fftw_destroy_plan( backward_plan_batch[mfi] );
 #endif
         }
     }
 }
 
+
 /* \brief Transform the component `i_comp` of MultiFab `mf`
  *  to spectral space, and store the corresponding result internally
  *  (in the spectral field specified by `field_index`) */
@@ -136,45 +214,90 @@ void
 SpectralFieldData::ForwardTransform( const MultiFab& mf,
                                      const int field_index,
                                      const int i_comp )
+{
+    ForwardTransformBatch( {&mf}, {field_index}, {i_comp}, 0, 1 );
+}
+
+/* \brief Transform the components `i_comp[n]` of the MultiFabs `mf[n]`
+ *  to spectral space, and store the corresponding results internally
+ *  (in the spectral fields specified by `field_index[n]`).
+ *  The components are transformed by groups of `n_batch`. */
+void
+SpectralFieldData::ForwardTransform( const Vector<const MultiFab*>& mf,
+                                     const Vector<int>& field_index,
+                                     const Vector<int>& i_comp )
+{
+    const int n_transforms = mf.size();
+    AMREX_ALWAYS_ASSERT( static_cast<int>(field_index.size()) == n_transforms &&
+                         static_cast<int>(i_comp.size()) == n_transforms );
+    for (int start = 0; start < n_transforms; start += n_batch) {
+        const int nb = std::min(n_batch, n_transforms - start);
+        ForwardTransformBatch( mf, field_index, i_comp, start, nb );
+    }
+}
+
+void
+SpectralFieldData::ForwardTransformBatch( const Vector<const MultiFab*>& mf,
+                                          const Vector<int>& field_index,
+                                          const Vector<int>& i_comp,
+                                          const int start, const int nb )
 {
     // Check field index type, in order to apply proper shift in spectral space
-    const bool is_nodal_x = mf.is_nodal(0);
+    // and gather the source/destination components of each transform
+    GpuArray<int,n_batch> is_nodal_x, is_nodal_z;
+#if (AMREX_SPACEDIM == 3)
+    GpuArray<int,n_batch> is_nodal_y;
+#endif
+    GpuArray<int,n_batch> src_comp, dst_comp;
+    for (int n = 0; n < nb; ++n) {
+        const MultiFab& mfn = *mf[start+n];
+        is_nodal_x[n] = mfn.is_nodal(0);
 #if (AMREX_SPACEDIM == 3)
-    const bool is_nodal_y = mf.is_nodal(1);
-    const bool is_nodal_z = mf.is_nodal(2);
+        is_nodal_y[n] = mfn.is_nodal(1);
+        is_nodal_z[n] = mfn.is_nodal(2);
 #else
-    const bool is_nodal_z = mf.is_nodal(1);
+        is_nodal_z[n] = mfn.is_nodal(1);
 #endif
+        src_comp[n] = i_comp[start+n];
+        dst_comp[n] = field_index[start+n];
+    }
 
     // Loop over boxes
-    for ( MFIter mfi(mf); mfi.isValid(); ++mfi ){
+    for ( MFIter mfi(tmpRealField); mfi.isValid(); ++mfi ){
 
-        // Copy the real-space field `mf` to the temporary field `tmpRealField`
+        // Copy the real-space fields `mf` to the temporary field `tmpRealField`
+        // (one component per transform)
         // This ensures that all fields have the same number of points
         // before the Fourier transform.
         // As a consequence, the copy discards the *last* point of `mf`
         // in any direction that has *nodal* index type.
         {
-            Box realspace_bx = mf[mfi].box(); // Copy the box
-            realspace_bx.enclosedCells(); // Discard last point in nodal direction
-            AMREX_ALWAYS_ASSERT( realspace_bx == tmpRealField[mfi].box() );
-            Array4<const Real> mf_arr = mf[mfi].array();
+            const Box realspace_bx = tmpRealField[mfi].box();
+            GpuArray<Array4<const Real>,n_batch> mf_arr;
+            for (int n = 0; n < nb; ++n) {
+                Box bx = (*mf[start+n])[mfi].box(); // Copy the box
+                bx.enclosedCells(); // Discard last point in nodal direction
+                AMREX_ALWAYS_ASSERT( bx == realspace_bx );
+                mf_arr[n] = (*mf[start+n])[mfi].array();
+            }
             Array4<Real> tmp_arr = tmpRealField[mfi].array();
-            ParallelFor( realspace_bx,
-            [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-                tmp_arr(i,j,k) = mf_arr(i,j,k,i_comp);
+            ParallelFor( realspace_bx, nb,
+            [=] AMREX_GPU_DEVICE(int i, int j, int k, int n) noexcept {
+                tmp_arr(i,j,k,n) = mf_arr[n](i,j,k,src_comp[n]);
             });
         }
 
         // Perform Fourier transform from `tmpRealField` to `tmpSpectralField`
+        // (a single batched transform, unless only one component is needed)
 #ifdef AMREX_USE_GPU
         // Perform Fast Fourier Transform on GPU using cuFFT
         // make sure that this is done on the same
         // GPU stream as the above copy
+        cufftHandle& plan = (nb == 1) ? forward_plan[mfi] : forward_plan_batch[mfi];
         cufftResult result;
         cudaStream_t stream = amrex::Gpu::Device::cudaStream();
-        cufftSetStream ( forward_plan[mfi], stream);
-        result = cufftExecD2Z( forward_plan[mfi],
+        cufftSetStream ( plan, stream);
+        result = cufftExecD2Z( plan,
                                tmpRealField[mfi].dataPtr(),
                                reinterpret_cast<cuDoubleComplex*>(
                                tmpSpectralField[mfi].dataPtr()) );
@@ -182,7 +305,7 @@ SpectralFieldData::ForwardTransform( const MultiFab& mf,
            amrex::Print() << " forward transform using cufftExecD2Z failed ! \n";
         }
 #else
-        fftw_execute( forward_plan[mfi] );
+        fftw_execute( (nb == 1) ? forward_plan[mfi] : forward_plan_batch[mfi] );
 #endif
 
         // Copy the spectral-space field `tmpSpectralField` to the appropriate
@@ -200,19 +323,19 @@ SpectralFieldData::ForwardTransform( const MultiFab& mf,
             // Loop over indices within one box
             const Box spectralspace_bx = tmpSpectralField[mfi].box();
 
-            ParallelFor( spectralspace_bx,
-            [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-                Complex spectral_field_value = tmp_arr(i,j,k);
+            ParallelFor( spectralspace_bx, nb,
+            [=] AMREX_GPU_DEVICE(int i, int j, int k, int n) noexcept {
+                Complex spectral_field_value = tmp_arr(i,j,k,n);
                 // Apply proper shift in each dimension
-                if (is_nodal_x==false) spectral_field_value *= xshift_arr[i];
+                if (!is_nodal_x[n]) spectral_field_value *= xshift_arr[i];
 #if (AMREX_SPACEDIM == 3)
-                if (is_nodal_y==false) spectral_field_value *= yshift_arr[j];
-                if (is_nodal_z==false) spectral_field_value *= zshift_arr[k];
+                if (!is_nodal_y[n]) spectral_field_value *= yshift_arr[j];
+                if (!is_nodal_z[n]) spectral_field_value *= zshift_arr[k];
 #elif (AMREX_SPACEDIM == 2)
-                if (is_nodal_z==false) spectral_field_value *= zshift_arr[j];
+                if (!is_nodal_z[n]) spectral_field_value *= zshift_arr[j];
 #endif
                 // Copy field into the right index
-                fields_arr(i,j,k,field_index) = spectral_field_value;
+                fields_arr(i,j,k,dst_comp[n]) = spectral_field_value;
             });
         }
     }
@@ -225,18 +348,53 @@ void
 SpectralFieldData::BackwardTransform( MultiFab& mf,
                                       const int field_index,
                                       const int i_comp )
+{
+    BackwardTransformBatch( {&mf}, {field_index}, {i_comp}, 0, 1 );
+}
+
+/* \brief Transform the spectral fields specified by `field_index[n]` back
+ * to real space, and store them in the components `i_comp[n]` of `mf[n]`.
+ * The components are transformed by groups of `n_batch`. */
+void
+SpectralFieldData::BackwardTransform( const Vector<MultiFab*>& mf,
+                                      const Vector<int>& field_index,
+                                      const Vector<int>& i_comp )
+{
+    const int n_transforms = mf.size();
+    AMREX_ALWAYS_ASSERT( static_cast<int>(field_index.size()) == n_transforms &&
+                         static_cast<int>(i_comp.size()) == n_transforms );
+    for (int start = 0; start < n_transforms; start += n_batch) {
+        const int nb = std::min(n_batch, n_transforms - start);
+        BackwardTransformBatch( mf, field_index, i_comp, start, nb );
+    }
+}
+
+void
+SpectralFieldData::BackwardTransformBatch( const Vector<MultiFab*>& mf,
+                                           const Vector<int>& field_index,
+                                           const Vector<int>& i_comp,
+                                           const int start, const int nb )
 {
     // Check field index type, in order to apply proper shift in spectral space
-    const bool is_nodal_x = mf.is_nodal(0);
+    GpuArray<int,n_batch> is_nodal_x, is_nodal_z;
 #if (AMREX_SPACEDIM == 3)
-    const bool is_nodal_y = mf.is_nodal(1);
-    const bool is_nodal_z = mf.is_nodal(2);
+    GpuArray<int,n_batch> is_nodal_y;
+#endif
+    GpuArray<int,n_batch> src_comp;
+    for (int n = 0; n < nb; ++n) {
+        const MultiFab& mfn = *mf[start+n];
+        is_nodal_x[n] = mfn.is_nodal(0);
+#if (AMREX_SPACEDIM == 3)
+        is_nodal_y[n] = mfn.is_nodal(1);
+        is_nodal_z[n] = mfn.is_nodal(2);
 #else
-    const bool is_nodal_z = mf.is_nodal(1);
+        is_nodal_z[n] = mfn.is_nodal(1);
 #endif
+        src_comp[n] = field_index[start+n];
+    }
 
     // Loop over boxes
-    for ( MFIter mfi(mf); mfi.isValid(); ++mfi ){
+    for ( MFIter mfi(tmpRealField); mfi.isValid(); ++mfi ){
 
         // Copy the spectral-space field `tmpSpectralField` to the appropriate
         // field (specified by the input argument field_index)
@@ -253,31 +411,33 @@ SpectralFieldData::BackwardTransform( MultiFab& mf,
             // Loop over indices within one box
             const Box spectralspace_bx = tmpSpectralField[mfi].box();
 
-            ParallelFor( spectralspace_bx,
-            [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-                Complex spectral_field_value = field_arr(i,j,k,field_index);
+            ParallelFor( spectralspace_bx, nb,
+            [=] AMREX_GPU_DEVICE(int i, int j, int k, int n) noexcept {
+                Complex spectral_field_value = field_arr(i,j,k,src_comp[n]);
                 // Apply proper shift in each dimension
-                if (is_nodal_x==false) spectral_field_value *= xshift_arr[i];
+                if (!is_nodal_x[n]) spectral_field_value *= xshift_arr[i];
 #if (AMREX_SPACEDIM == 3)
-                if (is_nodal_y==false) spectral_field_value *= yshift_arr[j];
-                if (is_nodal_z==false) spectral_field_value *= zshift_arr[k];
+                if (!is_nodal_y[n]) spectral_field_value *= yshift_arr[j];
+                if (!is_nodal_z[n]) spectral_field_value *= zshift_arr[k];
 #elif (AMREX_SPACEDIM == 2)
-                if (is_nodal_z==false) spectral_field_value *= zshift_arr[j];
+                if (!is_nodal_z[n]) spectral_field_value *= zshift_arr[j];
 #endif
                 // Copy field into temporary array
-                tmp_arr(i,j,k) = spectral_field_value;
+                tmp_arr(i,j,k,n) = spectral_field_value;
             });
         }
 
         // Perform Fourier transform from `tmpSpectralField` to `tmpRealField`
+        // (a single batched transform, unless only one component is needed)
 #ifdef AMREX_USE_GPU
         // Perform Fast Fourier Transform on GPU using cuFFT.
         // make sure that this is done on the same
         // GPU stream as the above copy
+        cufftHandle& plan = (nb == 1) ? backward_plan[mfi] : backward_plan_batch[mfi];
         cufftResult result;
         cudaStream_t stream = amrex::Gpu::Device::cudaStream();
-        cufftSetStream ( backward_plan[mfi], stream);
-        result = cufftExecZ2D( backward_plan[mfi],
+        cufftSetStream ( plan, stream);
+        result = cufftExecZ2D( plan,
                                reinterpret_cast<cuDoubleComplex*>(
                                tmpSpectralField[mfi].dataPtr()),
                                tmpRealField[mfi].dataPtr() );
@@ -285,25 +445,30 @@ SpectralFieldData::BackwardTransform( MultiFab& mf,
            amrex::Print() << " Backward transform using cufftexecZ2D failed! \n";
         }
 #else
-        fftw_execute( backward_plan[mfi] );
+        fftw_execute( (nb == 1) ? backward_plan[mfi] : backward_plan_batch[mfi] );
 #endif
 
-        // Copy the temporary field `tmpRealField` to the real-space field `mf`
+        // Copy the temporary field `tmpRealField` to the real-space fields `mf`
         // (only in the valid cells ; not in the guard cells)
         // Normalize (divide by 1/N) since the FFT+IFFT results in a factor N
         {
-            Array4<Real> mf_arr = mf[mfi].array();
             Array4<const Real> tmp_arr = tmpRealField[mfi].array();
             // Normalization: divide by the number of points in realspace
             // (includes the guard cells)
             const Box realspace_bx = tmpRealField[mfi].box();
             const Real inv_N = 1./realspace_bx.numPts();
 
-            ParallelFor( mfi.validbox(),
-            [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-                // Copy and normalize field
-                mf_arr(i,j,k,i_comp) = inv_N*tmp_arr(i,j,k);
-            });
+            for (int n = 0; n < nb; ++n) {
+                MultiFab& mfn = *mf[start+n];
+                Array4<Real> mf_arr = mfn[mfi].array();
+                const int dst_comp = i_comp[start+n];
+                // The valid box depends on the staggering of each MultiFab
+                ParallelFor( mfn.box(mfi.index()),
+                [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+                    // Copy and normalize field
+                    mf_arr(i,j,k,dst_comp) = inv_N*tmp_arr(i,j,k,n);
+                });
+            }
         }
     }
 }
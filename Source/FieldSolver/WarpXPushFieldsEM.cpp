@@ -17,6 +17,40 @@
 
 using namespace amrex;
 
+namespace {
+    /* \brief Grow the tile box `tbx` by `ngrow` cells into the guard cells,
+     * i.e. only on the sides where it touches the boundary of its valid box
+     * `validbox` (so that the tiles do not overlap), without going beyond
+     * `limit` (cell-centered; typically the domain, grown in the periodic
+     * directions).
+     */
+    Box
+    GrowTileBoxIntoGuards (const Box& tbx, const Box& validbox,
+                           const Box& limit, const int ngrow)
+    {
+        const Box vbx = amrex::convert(validbox, tbx.ixType());
+        Box bx = tbx;
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            if (bx.smallEnd(idim) == vbx.smallEnd(idim)) bx.growLo(idim, ngrow);
+            if (bx.bigEnd(idim) == vbx.bigEnd(idim)) bx.growHi(idim, ngrow);
+        }
+        return bx & amrex::convert(limit, tbx.ixType());
+    }
+
+    /* \brief Domain of level `geom`, grown by `ngrow` in the periodic
+     * directions: the fields are not advanced in the guard cells that
+     * are outside of a non-periodic domain */
+    Box
+    GuardCellUpdateLimit (const Geometry& geom, const int ngrow)
+    {
+        Box limit = geom.Domain();
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            if (geom.isPeriodic(idim)) limit.grow(idim, ngrow);
+        }
+        return limit;
+    }
+}
+
 #ifdef WARPX_USE_PSATD
 namespace {
     void
@@ -30,26 +64,23 @@ namespace {
         using Idx = SpectralFieldIndex;
 
         // Perform forward Fourier transform
-        solver.ForwardTransform(*Efield[0], Idx::Ex);
-        solver.ForwardTransform(*Efield[1], Idx::Ey);
-        solver.ForwardTransform(*Efield[2], Idx::Ez);
-        solver.ForwardTransform(*Bfield[0], Idx::Bx);
-        solver.ForwardTransform(*Bfield[1], Idx::By);
-        solver.ForwardTransform(*Bfield[2], Idx::Bz);
-        solver.ForwardTransform(*current[0], Idx::Jx);
-        solver.ForwardTransform(*current[1], Idx::Jy);
-        solver.ForwardTransform(*current[2], Idx::Jz);
-        solver.ForwardTransform(*rho, Idx::rho_old, 0);
-        solver.ForwardTransform(*rho, Idx::rho_new, 1);
+        // (batched: the components are transformed by groups)
+        solver.ForwardTransform(
+            {Efield[0].get(), Efield[1].get(), Efield[2].get(),
+             Bfield[0].get(), Bfield[1].get(), Bfield[2].get(),
+             current[0].get(), current[1].get(), current[2].get(),
+             rho.get(), rho.get()},
+            {Idx::Ex, Idx::Ey, Idx::Ez, Idx::Bx, Idx::By, Idx::Bz,
+             Idx::Jx, Idx::Jy, Idx::Jz, Idx::rho_old, Idx::rho_new},
+            {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1});
         // Advance fields in spectral space
         solver.pushSpectralFields();
         // Perform backward Fourier Transform
-        solver.BackwardTransform(*Efield[0], Idx::Ex);
-        solver.BackwardTransform(*Efield[1], Idx::Ey);
-        solver.BackwardTransform(*Efield[2], Idx::Ez);
-        solver.BackwardTransform(*Bfield[0], Idx::Bx);
-        solver.BackwardTransform(*Bfield[1], Idx::By);
-        solver.BackwardTransform(*Bfield[2], Idx::Bz);
+        solver.BackwardTransform(
+            {Efield[0].get(), Efield[1].get(), Efield[2].get(),
+             Bfield[0].get(), Bfield[1].get(), Bfield[2].get()},
+            {Idx::Ex, Idx::Ey, Idx::Ez, Idx::Bx, Idx::By, Idx::Bz},
+            {0, 0, 0, 0, 0, 0});
     }
 }
 
@@ -106,7 +137,7 @@ WarpX::EvolveB (int lev, Real a_dt)
 }
 
 void
-WarpX::EvolveB (int lev, PatchType patch_type, amrex::Real a_dt)
+WarpX::EvolveB (int lev, PatchType patch_type, amrex::Real a_dt, int ngrow)
 {
     const int patch_level = (patch_type == PatchType::fine) ? lev : lev-1;
     const std::array<Real,3>& dx = WarpX::CellSize(patch_level);
@@ -133,13 +164,16 @@ WarpX::EvolveB (int lev, PatchType patch_type, amrex::Real a_dt)
         Bz = Bfield_cp[lev][2].get();
     }
 
-    MultiFab* cost = costs[lev].get();
+    MultiFab* cost = getCosts(lev);
     const IntVect& rr = (lev > 0) ? refRatio(lev-1) : IntVect::TheUnitVector();
 
     // xmin is only used by the picsar kernel with cylindrical geometry,
     // in which case it is actually rmin.
     const Real xmin = Geom(0).ProbLo(0);
 
+    AMREX_ALWAYS_ASSERT(ngrow < Ex->nGrow());
+    const Box guard_limit = GuardCellUpdateLimit(Geom(patch_level), ngrow);
+
     // Loop through the grids, and over the tiles within each grid
 #ifdef _OPENMP
 #pragma omp parallel if (Gpu::notInLaunchRegion())
@@ -148,9 +182,14 @@ WarpX::EvolveB (int lev, PatchType patch_type, amrex::Real a_dt)
     {
         Real wt = amrex::second();
 
-        const Box& tbx  = mfi.tilebox(Bx_nodal_flag);
-        const Box& tby  = mfi.tilebox(By_nodal_flag);
-        const Box& tbz  = mfi.tilebox(Bz_nodal_flag);
+        Box tbx  = mfi.tilebox(Bx_nodal_flag);
+        Box tby  = mfi.tilebox(By_nodal_flag);
+        Box tbz  = mfi.tilebox(Bz_nodal_flag);
+        if (ngrow > 0) {
+            tbx = GrowTileBoxIntoGuards(tbx, mfi.validbox(), guard_limit, ngrow);
+            tby = GrowTileBoxIntoGuards(tby, mfi.validbox(), guard_limit, ngrow);
+            tbz = GrowTileBoxIntoGuards(tbz, mfi.validbox(), guard_limit, ngrow);
+        }
 
         auto const& Bxfab = Bx->array(mfi);
         auto const& Byfab = By->array(mfi);
@@ -288,7 +327,7 @@ WarpX::EvolveE (int lev, Real a_dt)
 }
 
 void
-WarpX::EvolveE (int lev, PatchType patch_type, amrex::Real a_dt)
+WarpX::EvolveE (int lev, PatchType patch_type, amrex::Real a_dt, int ngrow)
 {
     const Real mu_c2_dt = (PhysConst::mu0*PhysConst::c*PhysConst::c) * a_dt;
     const Real c2dt = (PhysConst::c*PhysConst::c) * a_dt;
@@ -326,13 +365,16 @@ WarpX::EvolveE (int lev, PatchType patch_type, amrex::Real a_dt)
         F  = F_cp[lev].get();
     }
 
-    MultiFab* cost = costs[lev].get();
+    MultiFab* cost = getCosts(lev);
     const IntVect& rr = (lev > 0) ? refRatio(lev-1) : IntVect::TheUnitVector();
 
     // xmin is only used by the picsar kernel with cylindrical geometry,
     // in which case it is actually rmin.
     const Real xmin = Geom(0).ProbLo(0);
 
+    AMREX_ALWAYS_ASSERT(ngrow < Bx->nGrow());
+    const Box guard_limit = GuardCellUpdateLimit(Geom(patch_level), ngrow);
+
     // Loop through the grids, and over the tiles within each grid
 #ifdef _OPENMP
 #pragma omp parallel if (Gpu::notInLaunchRegion())
@@ -341,9 +383,14 @@ WarpX::EvolveE (int lev, PatchType patch_type, amrex::Real a_dt)
     {
         Real wt = amrex::second();
 
-        const Box& tex  = mfi.tilebox(Ex_nodal_flag);
-        const Box& tey  = mfi.tilebox(Ey_nodal_flag);
-        const Box& tez  = mfi.tilebox(Ez_nodal_flag);
+        Box tex  = mfi.tilebox(Ex_nodal_flag);
+        Box tey  = mfi.tilebox(Ey_nodal_flag);
+        Box tez  = mfi.tilebox(Ez_nodal_flag);
+        if (ngrow > 0) {
+            tex = GrowTileBoxIntoGuards(tex, mfi.validbox(), guard_limit, ngrow);
+            tey = GrowTileBoxIntoGuards(tey, mfi.validbox(), guard_limit, ngrow);
+            tez = GrowTileBoxIntoGuards(tez, mfi.validbox(), guard_limit, ngrow);
+        }
 
         auto const& Exfab = Ex->array(mfi);
         auto const& Eyfab = Ey->array(mfi);
@@ -88,9 +88,9 @@ Filter::ApplyStencil (FArrayBox& dstfab, const FArrayBox& srcfab,
     DoFilter(tbx, tmp, dst, 0, dcomp, ncomp);
 }
 
-/* \brief Apply stencil (2D/3D, CPU/GPU)
+/* \brief Apply the full tensor-product stencil (2D/3D, GPU)
  */
-void Filter::DoFilter (const Box& tbx,
+void Filter::DoFilterFull (const Box& tbx,
                        Array4<Real const> const& tmp,
                        Array4<Real      > const& dst,
                        int scomp, int dcomp, int ncomp)
@@ -134,6 +134,30 @@ void Filter::DoFilter (const Box& tbx,
     });
 }
 
+/* \brief Apply a symmetric 1D stencil along direction idir (GPU):
+ * dst(i) = sum_m s[m]*(src(i-m)+src(i+m)), where s[0] is already halved.
+ */
+namespace {
+    void filter_1d_pass (const Box& bx,
+                         Array4<Real const> const& src, int scomp,
+                         Array4<Real      > const& dst, int dcomp, int ncomp,
+                         Real const* AMREX_RESTRICT s, int len, int idir)
+    {
+        const int di = (idir == 0);
+        const int dj = (idir == 1);
+        const int dk = (idir == 2);
+        AMREX_PARALLEL_FOR_4D ( bx, ncomp, i, j, k, n,
+        {
+            Real d = 0.0;
+            for (int m=0; m < len; ++m){
+                d += s[m]*( src(i-m*di,j-m*dj,k-m*dk,scomp+n)
+                           +src(i+m*di,j+m*dj,k+m*dk,scomp+n));
+            }
+            dst(i,j,k,dcomp+n) = d;
+        });
+    }
+}
+
 #else
 
 /* \brief Apply stencil on MultiFab (CPU version, 2D/3D).
@@ -196,10 +220,12 @@ Filter::ApplyStencil (FArrayBox& dstfab, const FArrayBox& srcfab,
     DoFilter(tbx, tmpfab.array(), dstfab.array(), 0, dcomp, ncomp);
 }
 
-void Filter::DoFilter (const Box& tbx,
-                       Array4<Real const> const& tmp,
-                       Array4<Real      > const& dst,
-                       int scomp, int dcomp, int ncomp)
+/* \brief Apply the full tensor-product stencil (2D/3D, CPU)
+ */
+void Filter::DoFilterFull (const Box& tbx,
+                           Array4<Real const> const& tmp,
+                           Array4<Real      > const& dst,
+                           int scomp, int dcomp, int ncomp)
 {
     const auto lo = amrex::lbound(tbx);
     const auto hi = amrex::ubound(tbx);
@@ -254,4 +280,101 @@ void Filter::DoFilter (const Box& tbx,
     }
 }
 
+/* \brief Apply a symmetric 1D stencil along direction idir (CPU):
+ * dst(i) = sum_m s[m]*(src(i-m)+src(i+m)), where s[0] is already halved.
+ * The innermost loop is always along x (unit stride), so that it vectorizes
+ * for all three directions.
+ */
+namespace {
+    void filter_1d_pass (const Box& bx,
+                         Array4<Real const> const& src, int scomp,
+                         Array4<Real      > const& dst, int dcomp, int ncomp,
+                         Real const* AMREX_RESTRICT s, int len, int idir)
+    {
+        const auto lo = amrex::lbound(bx);
+        const auto hi = amrex::ubound(bx);
+        const int di = (idir == 0);
+        const int dj = (idir == 1);
+        const int dk = (idir == 2);
+        for (int n = 0; n < ncomp; ++n) {
+            for     (int k = lo.z; k <= hi.z; ++k) {
+                for (int j = lo.y; j <= hi.y; ++j) {
+                    AMREX_PRAGMA_SIMD
+                    for (int i = lo.x; i <= hi.x; ++i) {
+                        dst(i,j,k,dcomp+n) = 0.0;
+                    }
+                    for (int m = 0; m < len; ++m) {
+                        const Real sm = s[m];
+                        const int mi = m*di;
+                        const int mj = m*dj;
+                        const int mk = m*dk;
+                        AMREX_PRAGMA_SIMD
+                        for (int i = lo.x; i <= hi.x; ++i) {
+                            dst(i,j,k,dcomp+n) += sm*( src(i-mi,j-mj,k-mk,scomp+n)
+                                                      +src(i+mi,j+mj,k+mk,scomp+n));
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
 #endif // #ifdef AMREX_USE_CUDA
+
+/* \brief Apply stencil (2D/3D, CPU/GPU)
+ */
+void Filter::DoFilter (const Box& tbx,
+                       Array4<Real const> const& tmp,
+                       Array4<Real      > const& dst,
+                       int scomp, int dcomp, int ncomp)
+{
+    if (use_separable) {
+        DoFilterSeparable(tbx, tmp, dst, scomp, dcomp, ncomp);
+    } else {
+        DoFilterFull(tbx, tmp, dst, scomp, dcomp, ncomp);
+    }
+}
+
+/* \brief Apply stencil as successive 1D passes along each direction
+ * (2D/3D, CPU/GPU). The stencil is the tensor product of stencil_x,
+ * stencil_y and stencil_z, so this gives the same result as DoFilterFull
+ * (up to round-off), at a cost that grows with the sum rather than the
+ * product of the stencil lengths. Each pass is done on the box grown in
+ * the directions that are not filtered yet.
+ */
+void Filter::DoFilterSeparable (const Box& tbx,
+                                Array4<Real const> const& tmp,
+                                Array4<Real      > const& dst,
+                                int scomp, int dcomp, int ncomp)
+{
+    amrex::Real const* AMREX_RESTRICT sx = stencil_x.data();
+    amrex::Real const* AMREX_RESTRICT sz = stencil_z.data();
+#if (AMREX_SPACEDIM == 3)
+    amrex::Real const* AMREX_RESTRICT sy = stencil_y.data();
+
+    // Filter along x, on tbx grown along y and z
+    const Box& bx1 = amrex::grow(amrex::grow(tbx, 1, slen.y-1), 2, slen.z-1);
+    FArrayBox fab1(bx1, ncomp);
+    Elixir eli1 = fab1.elixir();  // Prevent the tmp data from being deleted too early
+    filter_1d_pass(bx1, tmp, scomp, fab1.array(), 0, ncomp, sx, slen.x, 0);
+
+    // Filter along y, on tbx grown along z
+    const Box& bx2 = amrex::grow(tbx, 2, slen.z-1);
+    FArrayBox fab2(bx2, ncomp);
+    Elixir eli2 = fab2.elixir();
+    filter_1d_pass(bx2, fab1.array(), 0, fab2.array(), 0, ncomp, sy, slen.y, 1);
+
+    // Filter along z, into dst
+    filter_1d_pass(tbx, fab2.array(), 0, dst, dcomp, ncomp, sz, slen.z, 2);
+#else
+    // Filter along x, on tbx grown along z
+    const Box& bx1 = amrex::grow(tbx, 1, slen.y-1);
+    FArrayBox fab1(bx1, ncomp);
+    Elixir eli1 = fab1.elixir();  // Prevent the tmp data from being deleted too early
+    filter_1d_pass(bx1, tmp, scomp, fab1.array(), 0, ncomp, sx, slen.x, 0);
+
+    // Filter along z (second dimension in 2D), into dst
+    filter_1d_pass(tbx, fab1.array(), 0, dst, dcomp, ncomp, sz, slen.y, 1);
+#endif
+}
@@ -7,6 +7,7 @@
 #include <WarpX_f.H>
 #include <AMReX.H>
 #include <WarpX.H>
+#include <WarpXUtil.H>
 
 using namespace amrex;
 
@@ -129,6 +130,7 @@ PlasmaInjector::PlasmaInjector (int ispecies, const std::string& name)
         pp.get("q_tot", q_tot);
         pp.get("npart", npart);
         pp.query("do_symmetrize", do_symmetrize);
+        pp.query("random_seed", random_seed);
         gaussian_beam = true;
         parseMomentum(pp);
     }
@@ -167,27 +169,8 @@ PlasmaInjector::PlasmaInjector (int ispecies, const std::string& name)
 namespace {
 WarpXParser makeParser (std::string const& parse_function)
 {
-    WarpXParser parser(parse_function);
-    parser.registerVariables({"x","y","z"});
-
-    ParmParse pp("my_constants");
-    std::set<std::string> symbols = parser.symbols();
-    symbols.erase("x");
-    symbols.erase("y");
-    symbols.erase("z"); // after removing variables, we are left with constants
-    for (auto it = symbols.begin(); it != symbols.end(); ) {
-        Real v;
-        if (pp.query(it->c_str(), v)) {
-            parser.setConstant(*it, v);
-            it = symbols.erase(it);
-        } else {
-            ++it;
-        }
-    }
-    for (auto const& s : symbols) { // make sure there no unknown symbols
-        amrex::Abort("PlasmaInjector::makeParser: Unknown symbol "+s);
-    }
-
+    WarpXParser parser;
+    MakeParserFromInput(parser, parse_function, {"x","y","z"});
     return parser;
 }
 }
@@ -303,6 +286,12 @@ XDim3 PlasmaInjector::getMomentum (Real x, Real y, Real z) const noexcept
     return inj_mom->getMomentum(x, y, z); // gamma*beta
 }
 
+XDim3 PlasmaInjector::getMomentum (Real x, Real y, Real z,
+                                   XDim3 const& rn) const noexcept
+{
+    return inj_mom->getMomentum(x, y, z, rn); // gamma*beta
+}
+
 bool PlasmaInjector::insideBounds (Real x, Real y, Real z) const noexcept
 {
     return (x < xmax and x >= xmin and
@@ -201,6 +201,8 @@ WarpX::InitNCICorrector ()
             // Compute Godfrey filters stencils
             nci_godfrey_filter_exeybz[lev]->ComputeStencils();
             nci_godfrey_filter_bxbyez[lev]->ComputeStencils();
+            nci_godfrey_filter_exeybz[lev]->use_separable = WarpX::use_separable_filter;
+            nci_godfrey_filter_bxbyez[lev]->use_separable = WarpX::use_separable_filter;
         }
     }
 }
@@ -210,6 +212,7 @@ WarpX::InitFilter (){
     if (WarpX::use_filter){
         WarpX::bilinear_filter.npass_each_dir = WarpX::filter_npass_each_dir;
         WarpX::bilinear_filter.ComputeStencils();
+        WarpX::bilinear_filter.use_separable = WarpX::use_separable_filter;
     }
 }
 
@@ -6,8 +6,10 @@
 
 #include <WarpX.H>
 #include <WarpXConst.H>
+#include <WarpXUtil.H>
 #include <WarpX_f.H>
 #include <MultiParticleContainer.H>
+#include <GetAndSetPosition.H>
 
 using namespace amrex;
 
@@ -75,26 +77,7 @@ LaserParticleContainer::LaserParticleContainer (AmrCore* amr_core, int ispecies,
     if ( profile == laser_t::parse_field_function ) {
         // Parse the properties of the parse_field_function profile
         pp.get("field_function(X,Y,t)", field_function);
-        parser.define(field_function);
-        parser.registerVariables({"X","Y","t"});
-
-        ParmParse ppc("my_constants");
-        std::set<std::string> symbols = parser.symbols();
-        symbols.erase("X");
-        symbols.erase("Y");
-        symbols.erase("t"); // after removing variables, we are left with constants
-        for (auto it = symbols.begin(); it != symbols.end(); ) {
-            Real v;
-            if (ppc.query(it->c_str(), v)) {
-                parser.setConstant(*it, v);
-                it = symbols.erase(it);
-            } else {
-                ++it;
-            }
-        }
-        for (auto const& s : symbols) { // make sure there no unknown symbols
-            amrex::Abort("Laser Profile: Unknown symbol "+s);
-        }
+        MakeParserFromInput(parser, field_function, {"X","Y","t"});
     }
 
 	// Plane normal
@@ -393,11 +376,14 @@ LaserParticleContainer::Evolve (int lev,
                                 MultiFab* rho, MultiFab* crho,
                                 const MultiFab*, const MultiFab*, const MultiFab*,
                                 const MultiFab*, const MultiFab*, const MultiFab*,
-                                Real t, Real dt)
+                                Real t, Real dt, EvolveRegion region)
 {
+    // The laser particles do not gather the fields: they are all
+    // evolved while the guard cells of E and B are being exchanged
+    if (region == EvolveRegion::Boundary) return;
+
     BL_PROFILE("Laser::Evolve()");
-    BL_PROFILE_VAR_NS("Laser::Evolve::Copy", blp_copy);
-    BL_PROFILE_VAR_NS("PICSAR::LaserParticlePush", blp_pxr_pp);
+    BL_PROFILE_VAR_NS("Laser::ParticlePush", blp_pxr_pp);
     BL_PROFILE_VAR_NS("PICSAR::LaserCurrentDepo", blp_pxr_cd);
     BL_PROFILE_VAR_NS("Laser::Evolve::Accumulate", blp_accumulate);
 
@@ -440,18 +426,13 @@ LaserParticleContainer::Evolve (int lev,
             // For now, laser particles do not take the current buffers into account
             const long np_current = np;
 
-            m_giv[thread_num].resize(np);
-
             plane_Xp.resize(np);
             plane_Yp.resize(np);
             amplitude_E.resize(np);
 
-            //
-            // copy data from particle container to temp arrays
-            //
-            BL_PROFILE_VAR_START(blp_copy);
-            pti.GetPosition(m_xp[thread_num], m_yp[thread_num], m_zp[thread_num]);
-            BL_PROFILE_VAR_STOP(blp_copy);
+            // The positions are read and written in place in the particle structs
+            const GetParticlePosition getPosition(pti);
+            const SetParticlePosition setPosition(pti);
 
             if (rho) {
                 DepositCharge(pti, wp, rho, 0, 0, np_current, thread_num, lev, lev);
@@ -465,13 +446,30 @@ LaserParticleContainer::Evolve (int lev,
             //
             BL_PROFILE_VAR_START(blp_pxr_pp);
             // Find the coordinates of the particles in the emission plane
-            calculate_laser_plane_coordinates( &np,
-                                               m_xp[thread_num].dataPtr(),
-                                               m_yp[thread_num].dataPtr(),
-                                               m_zp[thread_num].dataPtr(),
-                                               plane_Xp.dataPtr(), plane_Yp.dataPtr(),
-                                               &u_X[0], &u_X[1], &u_X[2], &u_Y[0], &u_Y[1], &u_Y[2],
-                                               &position[0], &position[1], &position[2] );
+            {
+                Real* const AMREX_RESTRICT pXp = plane_Xp.dataPtr();
+                Real* const AMREX_RESTRICT pYp = plane_Yp.dataPtr();
+                const Real u_Xx = u_X[0], u_Xz = u_X[2];
+                const Real pos_x = position[0], pos_z = position[2];
+#if (AMREX_SPACEDIM == 3)
+                const Real u_Xy = u_X[1];
+                const Real u_Yx = u_Y[0], u_Yy = u_Y[1], u_Yz = u_Y[2];
+                const Real pos_y = position[1];
+#endif
+                amrex::ParallelFor( np,
+                    [=] AMREX_GPU_DEVICE (long i) {
+                        Real x, y, z;
+                        getPosition(i, x, y, z);
+#if (AMREX_SPACEDIM == 3)
+                        pXp[i] = u_Xx*(x - pos_x) + u_Xy*(y - pos_y) + u_Xz*(z - pos_z);
+                        pYp[i] = u_Yx*(x - pos_x) + u_Yy*(y - pos_y) + u_Yz*(z - pos_z);
+#else
+                        pXp[i] = u_Xx*(x - pos_x) + u_Xz*(z - pos_z);
+                        pYp[i] = 0.;
+#endif
+                    }
+                );
+            }
             // Calculate the laser amplitude to be emitted,
             // at the position of the emission plane
             if (profile == laser_t::Gaussian) {
@@ -488,21 +486,54 @@ LaserParticleContainer::Evolve (int lev,
             }
 
             if (profile == laser_t::parse_field_function) {
-                for (int i = 0; i < np; ++i) {
-                    amplitude_E[i] = parser.eval(plane_Xp[i], plane_Yp[i], t);
-                }
+                parser.evalBatch(np, plane_Xp.dataPtr(), plane_Yp.dataPtr(),
+                                 t, amplitude_E.dataPtr());
             }
             // Calculate the corresponding momentum and position for the particles
-            update_laser_particle(
-                                  &np,
-                                  m_xp[thread_num].dataPtr(),
-                                  m_yp[thread_num].dataPtr(),
-                                  m_zp[thread_num].dataPtr(),
-                                  uxp.dataPtr(), uyp.dataPtr(), uzp.dataPtr(),
-                                  m_giv[thread_num].dataPtr(),
-                                  wp.dataPtr(), amplitude_E.dataPtr(), &p_X[0], &p_X[1], &p_X[2],
-                                  &nvec[0], &nvec[1], &nvec[2], &mobility, &dt,
-                                  &PhysConst::c, &WarpX::beta_boost, &WarpX::gamma_boost );
+            {
+                const Real* const AMREX_RESTRICT w = wp.dataPtr();
+                const Real* const AMREX_RESTRICT amp = amplitude_E.dataPtr();
+                Real* const AMREX_RESTRICT ux = uxp.dataPtr();
+                Real* const AMREX_RESTRICT uy = uyp.dataPtr();
+                Real* const AMREX_RESTRICT uz = uzp.dataPtr();
+                const Real p_Xx = p_X[0], p_Xy = p_X[1], p_Xz = p_X[2];
+                const Real nvecx = nvec[0], nvecy = nvec[1], nvecz = nvec[2];
+                const Real mob = mobility;
+                const Real c = PhysConst::c;
+                const Real beta_boost = WarpX::beta_boost;
+                const Real gamma_boost = WarpX::gamma_boost;
+                amrex::ParallelFor( np,
+                    [=] AMREX_GPU_DEVICE (long i) {
+                        // Calculate the velocity according to the amplitude of E
+                        const Real sign_charge = std::copysign(Real(1.), w[i]);
+                        const Real v_over_c = sign_charge * mob * amp[i];
+                        // The velocity is along the laser polarization p_X
+                        Real vx = c * v_over_c * p_Xx;
+                        Real vy = c * v_over_c * p_Xy;
+                        Real vz = c * v_over_c * p_Xz;
+                        // When running in the boosted-frame, there is additional velocity along nvec
+                        if (gamma_boost > 1.) {
+                            vx -= c * beta_boost * nvecx;
+                            vy -= c * beta_boost * nvecy;
+                            vz -= c * beta_boost * nvecz;
+                        }
+                        // Get the corresponding momenta
+                        const Real gamma = gamma_boost/std::sqrt(1. - v_over_c*v_over_c);
+                        ux[i] = gamma * vx;
+                        uy[i] = gamma * vy;
+                        uz[i] = gamma * vz;
+                        // Push the particle positions
+                        Real x, y, z;
+                        getPosition(i, x, y, z);
+                        x += vx * dt;
+#if (AMREX_SPACEDIM == 3)
+                        y += vy * dt;
+#endif
+                        z += vz * dt;
+                        setPosition(i, x, y, z);
+                    }
+                );
+            }
             BL_PROFILE_VAR_STOP(blp_pxr_pp);
 
             //
@@ -520,13 +551,6 @@ LaserParticleContainer::Evolve (int lev,
                                lev, lev-1, dt);
             }
 
-            //
-            // copy particle data back
-            //
-            BL_PROFILE_VAR_START(blp_copy);
-            pti.SetPosition(m_xp[thread_num], m_yp[thread_num], m_zp[thread_num]);
-            BL_PROFILE_VAR_STOP(blp_copy);
-
             if (rho) {
                 DepositCharge(pti, wp, rho, 1, 0, np_current, thread_num, lev, lev);
                 if (crho) {
@@ -55,13 +55,12 @@ WarpX::UpdateAuxilaryData ()
     {
         const auto& crse_period = Geom(lev-1).periodicity();
         const IntVect& ng = Bfield_cp[lev][0]->nGrowVect();
-        const DistributionMapping& dm = Bfield_cp[lev][0]->DistributionMap();
 
         // B field
         {
-            MultiFab dBx(Bfield_cp[lev][0]->boxArray(), dm, 1, ng);
-            MultiFab dBy(Bfield_cp[lev][1]->boxArray(), dm, 1, ng);
-            MultiFab dBz(Bfield_cp[lev][2]->boxArray(), dm, 1, ng);
+            MultiFab& dBx = *Bfield_cdiff[lev][0];
+            MultiFab& dBy = *Bfield_cdiff[lev][1];
+            MultiFab& dBz = *Bfield_cdiff[lev][2];
             dBx.setVal(0.0);
             dBy.setVal(0.0);
             dBz.setVal(0.0);
@@ -84,7 +83,11 @@ WarpX::UpdateAuxilaryData ()
 #pragma omp parallel
 #endif
             {
-                std::array<FArrayBox,3> bfab;
+#ifdef _OPENMP
+                std::array<FArrayBox,3>& bfab = aux_interp_fab[omp_get_thread_num()];
+#else
+                std::array<FArrayBox,3>& bfab = aux_interp_fab[0];
+#endif
                 for (MFIter mfi(*Bfield_aux[lev][0]); mfi.isValid(); ++mfi)
                 {
                     Box ccbx = mfi.fabbox();
@@ -134,9 +137,9 @@ WarpX::UpdateAuxilaryData ()
 
         // E field
         {
-            MultiFab dEx(Efield_cp[lev][0]->boxArray(), dm, 1, ng);
-            MultiFab dEy(Efield_cp[lev][1]->boxArray(), dm, 1, ng);
-            MultiFab dEz(Efield_cp[lev][2]->boxArray(), dm, 1, ng);
+            MultiFab& dEx = *Efield_cdiff[lev][0];
+            MultiFab& dEy = *Efield_cdiff[lev][1];
+            MultiFab& dEz = *Efield_cdiff[lev][2];
             dEx.setVal(0.0);
             dEy.setVal(0.0);
             dEz.setVal(0.0);
@@ -154,11 +157,15 @@ WarpX::UpdateAuxilaryData ()
             MultiFab::Subtract(dEz, *Efield_cp[lev][2], 0, 0, 1, ng);
 
             const int refinement_ratio = refRatio(lev-1)[0];
-#ifdef _OPEMP
+#ifdef _OPENMP
 #pragma omp parallel
 #endif
             {
-                std::array<FArrayBox,3> efab;
+#ifdef _OPENMP
+                std::array<FArrayBox,3>& efab = aux_interp_fab[omp_get_thread_num()];
+#else
+                std::array<FArrayBox,3>& efab = aux_interp_fab[0];
+#endif
                 for (MFIter mfi(*Efield_aux[lev][0]); mfi.isValid(); ++mfi)
                 {
                     Box ccbx = mfi.fabbox();
@@ -235,6 +242,76 @@ WarpX::FillBoundaryF ()
     }
 }
 
+void
+WarpX::FillBoundaryEB ()
+{
+    // All the components are exchanged concurrently, in a single round
+    // of messages, instead of one round per field
+    for (int lev = 0; lev <= finest_level; ++lev)
+    {
+        const auto& period = Geom(lev).periodicity();
+        Vector<MultiFab*> mf{Efield_fp[lev][0].get(),Efield_fp[lev][1].get(),Efield_fp[lev][2].get(),
+                             Bfield_fp[lev][0].get(),Bfield_fp[lev][1].get(),Bfield_fp[lev][2].get()};
+        amrex::FillBoundary(mf, period);
+    }
+}
+
+void
+WarpX::FillBoundaryEB_nowait ()
+{
+    for (int lev = 0; lev <= finest_level; ++lev)
+    {
+        // The exchange with the PML is local to the boxes that touch it
+        if (do_pml && pml[lev]->ok())
+        {
+            pml[lev]->ExchangeE(PatchType::fine,
+                                { Efield_fp[lev][0].get(),
+                                  Efield_fp[lev][1].get(),
+                                  Efield_fp[lev][2].get() });
+            pml[lev]->FillBoundaryE(PatchType::fine);
+            pml[lev]->ExchangeB(PatchType::fine,
+                                { Bfield_fp[lev][0].get(),
+                                  Bfield_fp[lev][1].get(),
+                                  Bfield_fp[lev][2].get() });
+            pml[lev]->FillBoundaryB(PatchType::fine);
+        }
+
+        const auto& period = Geom(lev).periodicity();
+        for (int idim = 0; idim < 3; ++idim) {
+            Efield_fp[lev][idim]->FillBoundary_nowait(period);
+            Bfield_fp[lev][idim]->FillBoundary_nowait(period);
+        }
+    }
+    eb_exchange_in_flight = true;
+}
+
+void
+WarpX::FillBoundaryEB_finish ()
+{
+    if (!eb_exchange_in_flight) return;
+    for (int lev = 0; lev <= finest_level; ++lev)
+    {
+        for (int idim = 0; idim < 3; ++idim) {
+            Efield_fp[lev][idim]->FillBoundary_finish();
+            Bfield_fp[lev][idim]->FillBoundary_finish();
+        }
+    }
+    eb_exchange_in_flight = false;
+}
+
+void
+WarpX::FillBoundaryJ ()
+{
+    // The guard cells of J are only needed by the communication-avoiding
+    // update, which advances E in its guard cells
+    for (int lev = 0; lev <= finest_level; ++lev)
+    {
+        const auto& period = Geom(lev).periodicity();
+        Vector<MultiFab*> mf{current_fp[lev][0].get(),current_fp[lev][1].get(),current_fp[lev][2].get()};
+        amrex::FillBoundary(mf, period);
+    }
+}
+
 void
 WarpX::FillBoundaryE(int lev)
 {
@@ -395,7 +472,7 @@ WarpX::SyncCurrent (const std::array<const amrex::MultiFab*,3>& fine,
     BL_ASSERT(refinement_ratio == 2);
     const IntVect& ng = (fine[0]->nGrowVect() + 1) /refinement_ratio;
 
-#ifdef _OPEMP
+#ifdef _OPENMP
 #pragma omp parallel
 #endif
     {
@@ -419,6 +496,56 @@ WarpX::SyncCurrent (const std::array<const amrex::MultiFab*,3>& fine,
     }
 }
 
+/** \brief Start summing the guard cells of the current (after the filter,
+ *  if any), without waiting for the messages. Single level only: there
+ *  is no coarse patch to restrict to. Completed by SyncCurrent_finish.
+ */
+void
+WarpX::SyncCurrent_nowait ()
+{
+    BL_PROFILE("SyncCurrent_nowait()");
+
+    current_fp_filtered.resize(finest_level+1);
+    for (int lev = 0; lev <= finest_level; ++lev) {
+        const auto& period = Geom(lev).periodicity();
+        for (int idim = 0; idim < 3; ++idim) {
+            MultiFab& j = *current_fp[lev][idim];
+            if (use_filter) {
+                IntVect ng = j.nGrowVect();
+                ng += bilinear_filter.stencil_length_each_dir-1;
+                current_fp_filtered[lev][idim].reset(
+                    new MultiFab(j.boxArray(), j.DistributionMap(), 1, ng));
+                bilinear_filter.ApplyStencil(*current_fp_filtered[lev][idim], j);
+                WarpXSumGuardCells_nowait(*current_fp_filtered[lev][idim], period);
+            } else {
+                WarpXSumGuardCells_nowait(j, period);
+            }
+        }
+    }
+    j_sum_in_flight = true;
+}
+
+void
+WarpX::SyncCurrent_finish ()
+{
+    if (!j_sum_in_flight) return;
+    BL_PROFILE("SyncCurrent_finish()");
+
+    for (int lev = 0; lev <= finest_level; ++lev) {
+        for (int idim = 0; idim < 3; ++idim) {
+            if (use_filter) {
+                WarpXSumGuardCells_finish(*current_fp[lev][idim],
+                                          *current_fp_filtered[lev][idim]);
+                current_fp_filtered[lev][idim].reset();
+            } else {
+                WarpXSumGuardCells_finish(*current_fp[lev][idim]);
+            }
+        }
+        NodalSyncJ(lev, PatchType::fine);
+    }
+    j_sum_in_flight = false;
+}
+
 void
 WarpX::SyncRho ()
 {
@@ -453,7 +580,7 @@ WarpX::SyncRho (const MultiFab& fine, MultiFab& crse, int refinement_ratio)
     const IntVect& ng = (fine.nGrowVect()+1)/refinement_ratio;
     const int nc = fine.nComp();
 
-#ifdef _OPEMP
+#ifdef _OPENMP
 #pragma omp parallel
 #endif
     {
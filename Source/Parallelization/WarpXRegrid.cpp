@@ -2,8 +2,122 @@
 #include <WarpX.H>
 #include <AMReX_BLProfiler.H>
 
+#include <algorithm>
+#include <cmath>
+
 using namespace amrex;
 
+namespace
+{
+    /* \brief Total cost of each box of `cost`, on all ranks */
+    Vector<Real>
+    GetCostsPerBox (const MultiFab& cost)
+    {
+        Vector<Real> box_costs(cost.size(), 0.0);
+        for (MFIter mfi(cost); mfi.isValid(); ++mfi) {
+            box_costs[mfi.index()] = cost[mfi].sum(mfi.validbox(), 0);
+        }
+        ParallelDescriptor::ReduceRealSum(box_costs.data(), box_costs.size());
+        return box_costs;
+    }
+
+    /* \brief Average over maximum cost per rank, when the boxes
+     * are distributed according to `dm` (1 is perfect balance) */
+    Real
+    ComputeEfficiency (const Vector<Real>& box_costs, const DistributionMapping& dm)
+    {
+        const int nprocs = ParallelDescriptor::NProcs();
+        Vector<Real> rank_costs(nprocs, 0.0);
+        for (int i = 0; i < static_cast<int>(box_costs.size()); ++i) {
+            rank_costs[dm[i]] += box_costs[i];
+        }
+        const Real max_cost = *std::max_element(rank_costs.begin(), rank_costs.end());
+        Real total_cost = 0.0;
+        for (const Real c : rank_costs) total_cost += c;
+        return (max_cost > 0.0) ? total_cost/(nprocs*max_cost) : 1.0;
+    }
+
+    /* \brief Distribution obtained by moving as few boxes as possible away
+     * from `dm`, until the maximum cost per rank is within `tolerance` of
+     * the average. A box is moved from the most loaded rank to its least
+     * loaded neighbor along the rank ordering (which follows the space-filling
+     * curve of the initial distribution), or to the least loaded rank
+     * if both neighbors are already above average or cannot take any box
+     * of the most loaded rank. */
+    DistributionMapping
+    MakeIncrementalDistributionMap (const Vector<Real>& box_costs,
+                                    const DistributionMapping& dm, Real tolerance)
+    {
+        const int nprocs = ParallelDescriptor::NProcs();
+        const int nboxes = box_costs.size();
+        Vector<int> pmap(dm.ProcessorMap());
+        Vector<Real> rank_costs(nprocs, 0.0);
+        Real total_cost = 0.0;
+        for (int i = 0; i < nboxes; ++i) {
+            rank_costs[pmap[i]] += box_costs[i];
+            total_cost += box_costs[i];
+        }
+        const Real target = (1.0+tolerance)*total_cost/nprocs;
+
+        for (int imove = 0; imove < nboxes; ++imove)
+        {
+            const int src = std::distance(rank_costs.begin(),
+                std::max_element(rank_costs.begin(), rank_costs.end()));
+            if (rank_costs[src] <= target) break;
+
+            // Box of src that reduces the most the maximum of the costs of
+            // src and dst, or -1. Any box cheaper than the difference of the
+            // costs reduces it; the best one is the closest to half of it.
+            auto find_box = [&] (int dst) {
+                const Real diff = rank_costs[src] - rank_costs[dst];
+                int ibox = -1;
+                for (int i = 0; i < nboxes; ++i) {
+                    if (pmap[i] == src && box_costs[i] > 0.0 && box_costs[i] < diff &&
+                        (ibox < 0 || std::abs(box_costs[i] - 0.5*diff) <
+                                     std::abs(box_costs[ibox] - 0.5*diff))) {
+                        ibox = i;
+                    }
+                }
+                return ibox;
+            };
+
+            int dst = -1;
+            for (const int r : {src-1, src+1}) {
+                if (r >= 0 && r < nprocs && rank_costs[r] < total_cost/nprocs &&
+                    (dst < 0 || rank_costs[r] < rank_costs[dst])) {
+                    dst = r;
+                }
+            }
+            int ibox = (dst < 0) ? -1 : find_box(dst);
+            if (ibox < 0) {
+                // No neighbor can take a box: try the least loaded rank,
+                // which allows moving a larger box
+                dst = std::distance(rank_costs.begin(),
+                    std::min_element(rank_costs.begin(), rank_costs.end()));
+                ibox = find_box(dst);
+            }
+            // No move improves the balance any further
+            if (ibox < 0) break;
+
+            pmap[ibox] = dst;
+            rank_costs[src] -= box_costs[ibox];
+            rank_costs[dst] += box_costs[ibox];
+        }
+        return DistributionMapping(pmap);
+    }
+
+    /* \brief Number of grid nodes in the shape factor of a particle */
+    Real
+    ShapeNodes ()
+    {
+#if (AMREX_SPACEDIM == 3)
+        return (WarpX::nox+1)*(WarpX::noy+1)*(WarpX::noz+1);
+#else
+        return (WarpX::nox+1)*(WarpX::noz+1);
+#endif
+    }
+}
+
 void
 WarpX::LoadBalance ()
 {
@@ -12,18 +126,108 @@ WarpX::LoadBalance ()
 
     AMREX_ALWAYS_ASSERT(costs[0] != nullptr);
 
+    if (load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Calibrated) {
+        CalibrateCostsHeuristic();
+    }
+    if (load_balance_costs_update_algo != LoadBalanceCostsUpdateAlgo::Timers) {
+        ComputeCostsHeuristic();
+    }
+
+    bool remade = false;
     for (int lev = 0; lev <= finestLevel(); ++lev)
     {
-        const Real nboxes = costs[lev]->size();
-        const Real nprocs = ParallelDescriptor::NProcs();
-        const int nmax = static_cast<int>(std::ceil(nboxes/nprocs*load_balance_knapsack_factor));
-        const DistributionMapping newdm = (load_balance_with_sfc)
-	  ? DistributionMapping::makeSFC(*costs[lev], false)
-            : DistributionMapping::makeKnapSack(*costs[lev], nmax);
-        RemakeLevel(lev, t_new[lev], boxArray(lev), newdm);
+        const Vector<Real> box_costs = GetCostsPerBox(*costs[lev]);
+
+        DistributionMapping newdm;
+        if (load_balance_incremental) {
+            newdm = MakeIncrementalDistributionMap(box_costs, DistributionMap(lev),
+                                                   load_balance_imbalance_tolerance);
+        } else {
+            const Real nboxes = costs[lev]->size();
+            const Real nprocs = ParallelDescriptor::NProcs();
+            const int nmax = static_cast<int>(std::ceil(nboxes/nprocs*load_balance_knapsack_factor));
+            newdm = (load_balance_with_sfc)
+                ? DistributionMapping::makeSFC(*costs[lev], false)
+                : DistributionMapping::makeKnapSack(*costs[lev], nmax);
+        }
+
+        // Only redistribute if the gain is worth the cost of moving the data
+        const Real current_efficiency = ComputeEfficiency(box_costs, DistributionMap(lev));
+        const Real proposed_efficiency = ComputeEfficiency(box_costs, newdm);
+        if (verbose) {
+            amrex::Print() << "Load balance on level " << lev
+                           << ": current efficiency " << current_efficiency
+                           << ", proposed efficiency " << proposed_efficiency << "\n";
+        }
+        if (load_balance_efficiency_ratio_threshold <= 1.0 ||
+            proposed_efficiency > load_balance_efficiency_ratio_threshold*current_efficiency)
+        {
+            RemakeLevel(lev, t_new[lev], boxArray(lev), newdm);
+            remade = true;
+        }
+    }
+
+    if (remade) mypc->Redistribute();
+}
+
+void
+WarpX::ComputeCostsHeuristic ()
+{
+    const Real particle_wt = costs_heuristic_particles_wt*ShapeNodes();
+    for (int lev = 0; lev <= finestLevel(); ++lev)
+    {
+        const Vector<long> np_per_box = mypc->NumberOfParticlesInGrid(lev);
+        for (MFIter mfi(*costs[lev]); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.validbox();
+            // The cost of the box is spread uniformly over its cells
+            const Real wt = costs_heuristic_cells_wt
+                + particle_wt*np_per_box[mfi.index()]/bx.d_numPts();
+            Array4<Real> const& costarr = costs[lev]->array(mfi);
+            amrex::ParallelFor(bx,
+            [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+            {
+                costarr(i,j,k) = wt;
+            });
+        }
     }
+}
 
-    mypc->Redistribute();
+void
+WarpX::CalibrateCostsHeuristic ()
+{
+    // Least-squares fit of the measured cost of each box by
+    // particles_wt*(shape nodes)*(number of particles) + cells_wt*(number of cells)
+    Real spp = 0.0, spc = 0.0, scc = 0.0, spt = 0.0, sct = 0.0;
+    for (int lev = 0; lev <= finestLevel(); ++lev)
+    {
+        const Vector<long> np_per_box = mypc->NumberOfParticlesInGrid(lev);
+        const Vector<Real> box_costs = GetCostsPerBox(*costs[lev]);
+        const BoxArray& ba = costs[lev]->boxArray();
+        for (int i = 0; i < static_cast<int>(box_costs.size()); ++i) {
+            const Real p = ShapeNodes()*np_per_box[i];
+            const Real c = ba[i].d_numPts();
+            spp += p*p;
+            spc += p*c;
+            scc += c*c;
+            spt += p*box_costs[i];
+            sct += c*box_costs[i];
+        }
+    }
+    const Real det = spp*scc - spc*spc;
+    // Keep the previous weights if the boxes do not discriminate
+    // between the two contributions (e.g. no particles)
+    if (det <= 1.e-12*spp*scc) return;
+    const Real particles_wt = (spt*scc - sct*spc)/det;
+    const Real cells_wt = (spp*sct - spc*spt)/det;
+    if (particles_wt <= 0.0 || cells_wt < 0.0) return;
+    costs_heuristic_particles_wt = particles_wt;
+    costs_heuristic_cells_wt = cells_wt;
+    if (verbose) {
+        amrex::Print() << "Calibrated cost weights: " << costs_heuristic_particles_wt
+                       << " per particle and shape node, " << costs_heuristic_cells_wt
+                       << " per cell\n";
+    }
 }
 
 void
@@ -138,6 +342,16 @@ WarpX::RemakeLevel (int lev, Real time, const BoxArray& ba, const DistributionMa
                     pmf->Redistribute(*Efield_cp[lev][idim], 0, 0, 1, ng);
                     Efield_cp[lev][idim] = std::move(pmf);
                 }
+                {
+                    const IntVect& ng = Bfield_cdiff[lev][idim]->nGrowVect();
+                    Bfield_cdiff[lev][idim].reset(new MultiFab(Bfield_cdiff[lev][idim]->boxArray(),
+                                                               dm, 1, ng));
+                }
+                {
+                    const IntVect& ng = Efield_cdiff[lev][idim]->nGrowVect();
+                    Efield_cdiff[lev][idim].reset(new MultiFab(Efield_cdiff[lev][idim]->boxArray(),
+                                                               dm, 1, ng));
+                }
                 {
                     const IntVect& ng = current_cp[lev][idim]->nGrowVect();
                     auto pmf = std::unique_ptr<MultiFab>( new MultiFab(current_cp[lev][idim]->boxArray(),
@@ -52,6 +52,8 @@ GpuParser::GpuParser (WarpXParser const& wp)
         wp_parser_regvar(m_parser[tid], "z", &(m_var[tid].z));
     }
 
+    m_bytecode = wp_bytecode_compile(m_parser[0]->ast, {"x", "y", "z"});
+
 #endif // AMREX_USE_GPU
 }
 
@@ -68,6 +70,8 @@ GpuParser::clear ()
     }
     ::delete[] m_parser;
     ::delete[] m_var;
+    wp_bytecode_delete(m_bytecode);
+    m_bytecode = nullptr;
 #endif
 }
 
@@ -1,5 +1,6 @@
 
 #include <algorithm>
+#include <cctype>
 #include "WarpXParser.H"
 
 WarpXParser::WarpXParser (std::string const& func_body)
@@ -15,12 +16,13 @@ WarpXParser::define (std::string const& func_body)
     m_expression = func_body;
     m_expression.erase(std::remove(m_expression.begin(),m_expression.end(),'\n'),
                        m_expression.end());
-    std::string f = m_expression + "\n";
+    std::string f = expandFunctions(m_expression, 0) + "\n";
 
 #ifdef _OPENMP
 
     int nthreads = omp_get_max_threads();
     m_variables.resize(nthreads);
+    m_bytecode_stale.assign(nthreads, 0);
     m_parser.resize(nthreads);
     m_parser[0] = wp_c_parser_new(f.c_str());
 #pragma omp parallel
@@ -38,6 +40,107 @@ WarpXParser::define (std::string const& func_body)
 #endif
 }
 
+void
+WarpXParser::defineFunction (std::string const& name,
+                             std::vector<std::string> const& args,
+                             std::string const& body)
+{
+    std::string b = body;
+    b.erase(std::remove(b.begin(),b.end(),'\n'), b.end());
+    m_functions[name] = Function{args, b};
+}
+
+namespace {
+    bool is_ident_start (char c) { return std::isalpha(c) || c == '_'; }
+    bool is_ident_char (char c) { return std::isalnum(c) || c == '_'; }
+    // True if the identifier starting at s[i] is the exponent of a number
+    // (e.g. the "e" of 1.e5), rather than a symbol.
+    bool in_number (std::string const& s, std::size_t i) {
+        return i > 0 && (std::isdigit(s[i-1]) || s[i-1] == '.');
+    }
+}
+
+std::string
+WarpXParser::expandFunctions (std::string const& s, int depth) const
+{
+    if (m_functions.empty()) return s;
+    if (depth > 32) {
+        yyerror("WarpXParser: user-defined functions nested too deep (recursive?) in %s",
+                s.c_str());
+        exit(1);
+    }
+
+    std::string result;
+    std::size_t i = 0;
+    while (i < s.size())
+    {
+        if (!is_ident_start(s[i]) || in_number(s, i)) {
+            result += s[i++];
+            continue;
+        }
+        std::size_t j = i;
+        while (j < s.size() && is_ident_char(s[j])) ++j;
+        const std::string name = s.substr(i, j-i);
+        auto f = m_functions.find(name);
+        std::size_t k = j;
+        while (k < s.size() && std::isspace(s[k])) ++k;
+        if (f == m_functions.end() || k == s.size() || s[k] != '(') {
+            result += name;
+            i = j;
+            continue;
+        }
+
+        // Split the arguments at the top-level commas
+        std::vector<std::string> args(1);
+        int level = 0;
+        for (++k; k < s.size(); ++k) {
+            const char c = s[k];
+            if (c == '(') {
+                ++level;
+            } else if (c == ')') {
+                if (level == 0) break;
+                --level;
+            } else if (c == ',' && level == 0) {
+                args.emplace_back();
+                continue;
+            }
+            args.back() += c;
+        }
+        if (k == s.size() || args.size() != f->second.args.size()) {
+            yyerror("WarpXParser: wrong call to function %s in %s",
+                    name.c_str(), s.c_str());
+            exit(1);
+        }
+
+        // Replace the parameters by the arguments in the body, then expand
+        // the calls in the result (which come from the body or the arguments)
+        std::string const& body = f->second.body;
+        std::string inlined;
+        std::size_t ib = 0;
+        while (ib < body.size())
+        {
+            if (!is_ident_start(body[ib]) || in_number(body, ib)) {
+                inlined += body[ib++];
+                continue;
+            }
+            std::size_t jb = ib;
+            while (jb < body.size() && is_ident_char(body[jb])) ++jb;
+            const std::string sym = body.substr(ib, jb-ib);
+            auto const& params = f->second.args;
+            auto p = std::find(params.begin(), params.end(), sym);
+            if (p == params.end()) {
+                inlined += sym;
+            } else {
+                inlined += "(" + args[p-params.begin()] + ")";
+            }
+            ib = jb;
+        }
+        result += "(" + expandFunctions(inlined, depth+1) + ")";
+        i = k+1;
+    }
+    return result;
+}
+
 WarpXParser::~WarpXParser ()
 {
     clear();
@@ -59,12 +162,33 @@ WarpXParser::clear ()
     }
     m_parser.clear();
     m_variables.clear();
+    m_bytecode_stale.clear();
 
 #else
 
     if (m_parser) wp_parser_delete(m_parser);
     m_parser = nullptr;
 
+#endif
+
+    m_varnames.clear();
+    wp_bytecode_delete(m_bytecode);
+    m_bytecode = nullptr;
+}
+
+void
+WarpXParser::compile ()
+{
+    wp_bytecode_delete(m_bytecode);
+    m_bytecode = nullptr;
+#ifdef _OPENMP
+    std::fill(m_bytecode_stale.begin(), m_bytecode_stale.end(), 0);
+#endif
+    if (m_varnames.empty()) return;
+#ifdef _OPENMP
+    m_bytecode = wp_bytecode_compile(m_parser[0]->ast, m_varnames);
+#else
+    m_bytecode = wp_bytecode_compile(m_parser->ast, m_varnames);
 #endif
 }
 
@@ -90,6 +214,7 @@ WarpXParser::registerVariables (std::vector<std::string> const& names)
         const int tid = omp_get_thread_num();
         struct wp_parser* p = m_parser[tid];
         auto& v = m_variables[tid];
+        v.resize(names.size());
         for (int j = 0; j < names.size(); ++j) {
             wp_parser_regvar(p, names[j].c_str(), &(v[j]));
         }
@@ -97,11 +222,15 @@ WarpXParser::registerVariables (std::vector<std::string> const& names)
 
 #else
 
+    m_variables.resize(names.size());
     for (int j = 0; j < names.size(); ++j) {
         wp_parser_regvar(m_parser, names[j].c_str(), &(m_variables[j]));
     }
 
 #endif
+
+    m_varnames = names;
+    compile();
 }
 
 void
@@ -109,9 +238,19 @@ WarpXParser::setConstant (std::string const& name, double c)
 {
 #ifdef _OPENMP
 
-    bool in_parallel = omp_in_parallel();
     // We don't know if this is inside OMP parallel region or not
-#pragma omp parallel if (!in_parallel)
+    if (omp_in_parallel()) {
+        // Each thread sets the constant in its own parser. The bytecode
+        // is shared with the other threads, which may be evaluating it:
+        // do not touch it. This thread walks the AST until the next
+        // serial registerVariables or setConstant.
+        const int tid = omp_get_thread_num();
+        wp_parser_setconst(m_parser[tid], name.c_str(), c);
+        m_bytecode_stale[tid] = 1;
+        return;
+    }
+
+#pragma omp parallel
     {
         wp_parser_setconst(m_parser[omp_get_thread_num()], name.c_str(), c);
     }
@@ -121,6 +260,8 @@ WarpXParser::setConstant (std::string const& name, double c)
     wp_parser_setconst(m_parser, name.c_str(), c);
 
 #endif
+
+    compile();
 }
 
 void
@@ -0,0 +1,317 @@
+#include "wp_bytecode.h"
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <map>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+
+/* Builds the instruction stream in SSA form: every value (variable,
+ * constant or temporary) gets its own id.  Registers are assigned once
+ * the whole stream is known. */
+struct wp_compiler
+{
+    enum kind_t { VAR, CONST, TEMP };
+
+    explicit wp_compiler (std::vector<std::string> const& a_names)
+        : names(a_names)
+    {
+        for (int i = 0; i < static_cast<int>(names.size()); ++i) {
+            kind.push_back(VAR);
+            value.push_back(0.0);
+        }
+    }
+
+    int constant (double d)
+    {
+        // Key on the bit pattern, so that e.g. 0.0 and -0.0 stay distinct
+        std::uint64_t bits;
+        std::memcpy(&bits, &d, sizeof(d));
+        auto it = const_ids.find(bits);
+        if (it != const_ids.end()) return it->second;
+        const int id = newvalue(CONST, d);
+        const_ids[bits] = id;
+        return id;
+    }
+
+    int variable (char const* name)
+    {
+        for (int i = 0; i < static_cast<int>(names.size()); ++i) {
+            if (names[i] == name) return i;
+        }
+        ok = false;
+        return 0;
+    }
+
+    int op (enum wp_op_t o, int f, int a, int b = -1)
+    {
+        const bool unary = (o == WP_OP_NEG || o == WP_OP_F1);
+        // Constant folding, with the same arithmetic as the evaluation
+        if (kind[a] == CONST && (unary || kind[b] == CONST)) {
+            const double va = value[a];
+            const double vb = unary ? 0.0 : value[b];
+            switch (o) {
+            case WP_OP_ADD: return constant(va + vb);
+            case WP_OP_SUB: return constant(va - vb);
+            case WP_OP_MUL: return constant(va * vb);
+            case WP_OP_DIV: return constant(va / vb);
+            case WP_OP_NEG: return constant(-va);
+            case WP_OP_F1:  return constant(wp_call_f1((enum wp_f1_t)f, va));
+            case WP_OP_F2:  return constant(wp_call_f2((enum wp_f2_t)f, va, vb));
+            }
+        }
+        // Common subexpression elimination. a+b and b+a are the same in
+        // IEEE arithmetic, so the key of commutative operations is sorted.
+        std::array<int,4> key{{o, f, a, b}};
+        if ((o == WP_OP_ADD || o == WP_OP_MUL) && key[2] > key[3]) {
+            std::swap(key[2], key[3]);
+        }
+        auto it = cse_ids.find(key);
+        if (it != cse_ids.end()) return it->second;
+        const int id = newvalue(TEMP, 0.0);
+        code.push_back({o, f, id, a, b});
+        cse_ids[key] = id;
+        return id;
+    }
+
+    int emit (struct wp_node* node)
+    {
+        switch (node->type)
+        {
+        case WP_NUMBER:
+            return constant(((struct wp_number*)node)->value);
+        case WP_SYMBOL:
+            return variable(((struct wp_symbol*)node)->name);
+        case WP_ADD:
+        case WP_ADD_PP:
+            return op(WP_OP_ADD, 0, emit(node->l), emit(node->r));
+        case WP_SUB:
+        case WP_SUB_PP:
+            return op(WP_OP_SUB, 0, emit(node->l), emit(node->r));
+        case WP_MUL:
+        case WP_MUL_PP:
+            return op(WP_OP_MUL, 0, emit(node->l), emit(node->r));
+        case WP_DIV:
+        case WP_DIV_PP:
+            return op(WP_OP_DIV, 0, emit(node->l), emit(node->r));
+        case WP_NEG:
+        case WP_NEG_P:
+            return op(WP_OP_NEG, 0, emit(node->l));
+        // After optimization, lvp.v holds the left value and r the symbol
+        case WP_ADD_VP:
+            return op(WP_OP_ADD, 0, constant(node->lvp.v), emit(node->r));
+        case WP_SUB_VP:
+            return op(WP_OP_SUB, 0, constant(node->lvp.v), emit(node->r));
+        case WP_MUL_VP:
+            return op(WP_OP_MUL, 0, constant(node->lvp.v), emit(node->r));
+        case WP_DIV_VP:
+            return op(WP_OP_DIV, 0, constant(node->lvp.v), emit(node->r));
+        case WP_F1:
+            return emit_f1(((struct wp_f1*)node)->ftype,
+                           emit(((struct wp_f1*)node)->l));
+        case WP_F2:
+            return op(WP_OP_F2, ((struct wp_f2*)node)->ftype,
+                      emit(((struct wp_f2*)node)->l),
+                      emit(((struct wp_f2*)node)->r));
+        default:
+            yyerror("wp_bytecode_compile: unknown node type %d\n", node->type);
+            ok = false;
+            return 0;
+        }
+    }
+
+    // Integer powers become multiplications, in the order of wp_call_f1,
+    // so that a*a can be shared with the rest of the expression.
+    int emit_f1 (enum wp_f1_t f, int a)
+    {
+        switch (f)
+        {
+        case WP_POW_P1: return a;
+        case WP_POW_P2: return op(WP_OP_MUL, 0, a, a);
+        case WP_POW_P3: return op(WP_OP_MUL, 0, op(WP_OP_MUL, 0, a, a), a);
+        case WP_POW_M1: return op(WP_OP_DIV, 0, constant(1.0), a);
+        case WP_POW_M2: return op(WP_OP_DIV, 0, constant(1.0), op(WP_OP_MUL, 0, a, a));
+        case WP_POW_M3: return op(WP_OP_DIV, 0, constant(1.0),
+                                  op(WP_OP_MUL, 0, op(WP_OP_MUL, 0, a, a), a));
+        default:        return op(WP_OP_F1, f, a);
+        }
+    }
+
+    int newvalue (kind_t k, double v)
+    {
+        kind.push_back(k);
+        value.push_back(v);
+        return static_cast<int>(kind.size()) - 1;
+    }
+
+    std::vector<std::string> const& names;
+    std::vector<kind_t> kind;
+    std::vector<double> value;
+    std::map<std::uint64_t,int> const_ids;
+    std::map<std::array<int,4>,int> cse_ids;
+    std::vector<struct wp_instr> code;
+    bool ok = true;
+};
+
+}
+
+struct wp_bytecode*
+wp_bytecode_compile (struct wp_node* ast, std::vector<std::string> const& names)
+{
+    wp_compiler c(names);
+    const int result = c.emit(ast);
+    if (!c.ok) return nullptr;
+
+    const int nvalues = static_cast<int>(c.kind.size());
+    const int nvars = static_cast<int>(names.size());
+    const int ncode = static_cast<int>(c.code.size());
+
+    // Variables first, then constants
+    std::vector<int> reg(nvalues, -1);
+    int nregs = 0;
+    for (int v = 0; v < nvalues; ++v) {
+        if (c.kind[v] == wp_compiler::VAR) reg[v] = nregs++;
+    }
+    for (int v = 0; v < nvalues; ++v) {
+        if (c.kind[v] == wp_compiler::CONST) reg[v] = nregs++;
+    }
+
+    // Temporaries: reuse the register of a value after its last use, so
+    // that the register file stays small.  The destination is allocated
+    // before the operands are released, so it never aliases them.
+    std::vector<int> last_use(nvalues, -1);
+    for (int i = 0; i < ncode; ++i) {
+        last_use[c.code[i].a] = i;
+        if (c.code[i].b >= 0) last_use[c.code[i].b] = i;
+    }
+    last_use[result] = ncode;
+    std::vector<int> free_regs;
+    for (int i = 0; i < ncode; ++i) {
+        struct wp_instr& in = c.code[i];
+        const int dst = in.dst;
+        if (free_regs.empty()) {
+            reg[dst] = nregs++;
+        } else {
+            reg[dst] = free_regs.back();
+            free_regs.pop_back();
+        }
+        in.dst = reg[dst];
+        const int a = in.a;
+        const int b = in.b;
+        in.a = reg[a];
+        in.b = (b >= 0) ? reg[b] : in.a;
+        if (c.kind[a] == wp_compiler::TEMP && last_use[a] == i) {
+            free_regs.push_back(reg[a]);
+        }
+        if (b >= 0 && b != a && c.kind[b] == wp_compiler::TEMP && last_use[b] == i) {
+            free_regs.push_back(reg[b]);
+        }
+        if (last_use[dst] < 0) free_regs.push_back(reg[dst]);
+    }
+
+    struct wp_bytecode* bc = new wp_bytecode;
+    bc->ncode = ncode;
+    bc->code = new wp_instr[ncode > 0 ? ncode : 1];
+    for (int i = 0; i < ncode; ++i) bc->code[i] = c.code[i];
+    bc->nvars = nvars;
+    bc->nregs = nregs;
+    bc->result = reg[result];
+
+#ifdef _OPENMP
+    bc->nthreads = omp_get_max_threads();
+#else
+    bc->nthreads = 1;
+#endif
+    bc->regs = new double*[bc->nthreads];
+    bc->batch_regs = new double*[bc->nthreads];
+    for (int tid = 0; tid < bc->nthreads; ++tid) {
+        double* r = new double[nregs]();
+        double* br = new double[nregs*WP_BATCH_SIZE]();
+        for (int v = 0; v < nvalues; ++v) {
+            if (c.kind[v] == wp_compiler::CONST) {
+                r[reg[v]] = c.value[v];
+                for (int m = 0; m < WP_BATCH_SIZE; ++m) {
+                    br[reg[v]*WP_BATCH_SIZE+m] = c.value[v];
+                }
+            }
+        }
+        bc->regs[tid] = r;
+        bc->batch_regs[tid] = br;
+    }
+
+    return bc;
+}
+
+void
+wp_bytecode_delete (struct wp_bytecode* bc)
+{
+    if (bc == nullptr) return;
+    for (int tid = 0; tid < bc->nthreads; ++tid) {
+        delete[] bc->regs[tid];
+        delete[] bc->batch_regs[tid];
+    }
+    delete[] bc->regs;
+    delete[] bc->batch_regs;
+    delete[] bc->code;
+    delete bc;
+}
+
+#define WP_BATCH_LOOP(expr)                       \
+    AMREX_PRAGMA_SIMD                             \
+    for (int m = 0; m < WP_BATCH_SIZE; ++m) {     \
+        d[m] = (expr);                            \
+    }                                             \
+    break;
+
+void
+wp_bytecode_run_batch (struct wp_bytecode const* bc, double* r)
+{
+    for (int i = 0, n = bc->ncode; i < n; ++i)
+    {
+        struct wp_instr const& in = bc->code[i];
+        double* AMREX_RESTRICT d = r + in.dst*WP_BATCH_SIZE;
+        double const* a = r + in.a*WP_BATCH_SIZE;
+        double const* b = r + in.b*WP_BATCH_SIZE;
+        switch (in.op)
+        {
+        case WP_OP_ADD: WP_BATCH_LOOP(a[m] + b[m]);
+        case WP_OP_SUB: WP_BATCH_LOOP(a[m] - b[m]);
+        case WP_OP_MUL: WP_BATCH_LOOP(a[m] * b[m]);
+        case WP_OP_DIV: WP_BATCH_LOOP(a[m] / b[m]);
+        case WP_OP_NEG: WP_BATCH_LOOP(-a[m]);
+        case WP_OP_F1:
+            switch (in.f)
+            {
+            case WP_SQRT: WP_BATCH_LOOP(std::sqrt(a[m]));
+            case WP_EXP:  WP_BATCH_LOOP(std::exp(a[m]));
+            case WP_LOG:  WP_BATCH_LOOP(std::log(a[m]));
+            case WP_SIN:  WP_BATCH_LOOP(std::sin(a[m]));
+            case WP_COS:  WP_BATCH_LOOP(std::cos(a[m]));
+            case WP_ABS:  WP_BATCH_LOOP(std::fabs(a[m]));
+            default:      WP_BATCH_LOOP(wp_call_f1((enum wp_f1_t)in.f, a[m]));
+            }
+            break;
+        case WP_OP_F2:
+            switch (in.f)
+            {
+            case WP_POW: WP_BATCH_LOOP(std::pow(a[m], b[m]));
+            case WP_GT:  WP_BATCH_LOOP((a[m] >  b[m]) ? 1.0 : 0.0);
+            case WP_LT:  WP_BATCH_LOOP((a[m] <  b[m]) ? 1.0 : 0.0);
+            case WP_GEQ: WP_BATCH_LOOP((a[m] >= b[m]) ? 1.0 : 0.0);
+            case WP_LEQ: WP_BATCH_LOOP((a[m] <= b[m]) ? 1.0 : 0.0);
+            case WP_MIN: WP_BATCH_LOOP((a[m] <  b[m]) ? a[m] : b[m]);
+            case WP_MAX: WP_BATCH_LOOP((a[m] >  b[m]) ? a[m] : b[m]);
+            default:     WP_BATCH_LOOP(wp_call_f2((enum wp_f2_t)in.f, a[m], b[m]));
+            }
+            break;
+        }
+    }
+}
+
+#undef WP_BATCH_LOOP
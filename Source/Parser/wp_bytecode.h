@@ -0,0 +1,90 @@
+#ifndef WP_BYTECODE_H_
+#define WP_BYTECODE_H_
+
+#include "wp_parser_y.h"
+#include <AMReX_Extension.H>
+
+#include <string>
+#include <vector>
+
+/* The optimized AST of a wp_parser can be compiled into a flat,
+ * register-based instruction stream.  Registers [0,nvars) hold the
+ * variables (in the order of the names given to wp_bytecode_compile),
+ * they are followed by the constants and by the temporaries.  Constant
+ * subexpressions are folded and common subexpressions are computed only
+ * once.  The bytecode is only used on CPU; GPU kernels walk the AST.
+ */
+
+enum wp_op_t {
+    WP_OP_ADD = 1,
+    WP_OP_SUB,
+    WP_OP_MUL,
+    WP_OP_DIV,
+    WP_OP_NEG,
+    WP_OP_F1,
+    WP_OP_F2
+};
+
+/* dst = op(a, b).  f is the wp_f1_t or wp_f2_t of WP_OP_F1 and WP_OP_F2. */
+struct wp_instr {
+    enum wp_op_t op;
+    int f;
+    int dst;
+    int a;
+    int b;
+};
+
+/* Number of points evaluated together by wp_bytecode_run_batch */
+#define WP_BATCH_SIZE 8
+
+struct wp_bytecode {
+    struct wp_instr* code;
+    int ncode;
+    int nvars;
+    int nregs;
+    int result;
+    int nthreads;
+    /* Per-thread register files, with the constants already set.
+     * regs[tid] has nregs values; batch_regs[tid] has nregs rows of
+     * WP_BATCH_SIZE values. */
+    double** regs;
+    double** batch_regs;
+};
+
+/* Returns nullptr if the AST contains a symbol that is not in names. */
+struct wp_bytecode* wp_bytecode_compile (struct wp_node* ast,
+                                         std::vector<std::string> const& names);
+void wp_bytecode_delete (struct wp_bytecode* bc);
+
+/* Run the instructions on WP_BATCH_SIZE points at once.  The variable rows
+ * of r must be set by the caller; the result is in row bc->result. */
+void wp_bytecode_run_batch (struct wp_bytecode const* bc, double* r);
+
+/* Run the instructions on one point.  r[0,nvars) must be set by the
+ * caller (r is normally bc->regs[tid]). */
+inline double
+wp_bytecode_eval (struct wp_bytecode const* bc, double* AMREX_RESTRICT r)
+{
+    struct wp_instr const* code = bc->code;
+    for (int i = 0, n = bc->ncode; i < n; ++i)
+    {
+        struct wp_instr const& in = code[i];
+        switch (in.op)
+        {
+        case WP_OP_ADD: r[in.dst] = r[in.a] + r[in.b]; break;
+        case WP_OP_SUB: r[in.dst] = r[in.a] - r[in.b]; break;
+        case WP_OP_MUL: r[in.dst] = r[in.a] * r[in.b]; break;
+        case WP_OP_DIV: r[in.dst] = r[in.a] / r[in.b]; break;
+        case WP_OP_NEG: r[in.dst] = -r[in.a];          break;
+        case WP_OP_F1:
+            r[in.dst] = wp_call_f1((enum wp_f1_t)in.f, r[in.a]);
+            break;
+        case WP_OP_F2:
+            r[in.dst] = wp_call_f2((enum wp_f2_t)in.f, r[in.a], r[in.b]);
+            break;
+        }
+    }
+    return r[bc->result];
+}
+
+#endif
@@ -62,6 +62,29 @@ MultiParticleContainer::MultiParticleContainer (AmrCore* amr_core)
         pc_tmp->AddRealComp("uyold");
         pc_tmp->AddRealComp("uzold");
     }
+
+    // The fields gathered on the particles are only stored for the
+    // species that request them. They are not communicated, since they
+    // are recomputed at each step.
+    bool any_save_fields = false;
+    for (int i = 0; i < nspecies; ++i)
+    {
+        auto& pc = allcontainers[i];
+        if (pc->save_fields_on_particles)
+        {
+            for (const auto& name : ParticleStringNames::field_names) {
+                pc->AddRealComp(name, false);
+            }
+            any_save_fields = true;
+        }
+    }
+    if (any_save_fields)
+    {
+        pc_tmp->save_fields_on_particles = 1;
+        for (const auto& name : ParticleStringNames::field_names) {
+            pc_tmp->AddRealComp(name, false);
+        }
+    }
 }
 
 void
@@ -234,19 +257,23 @@ MultiParticleContainer::Evolve (int lev,
                                 MultiFab* rho, MultiFab* crho,
                                 const MultiFab* cEx, const MultiFab* cEy, const MultiFab* cEz,
                                 const MultiFab* cBx, const MultiFab* cBy, const MultiFab* cBz,
-                                Real t, Real dt)
+                                Real t, Real dt, EvolveRegion region)
 {
-    jx.setVal(0.0);
-    jy.setVal(0.0);
-    jz.setVal(0.0);
-    if (cjx) cjx->setVal(0.0);
-    if (cjy) cjy->setVal(0.0);
-    if (cjz) cjz->setVal(0.0);
-    if (rho) rho->setVal(0.0);
-    if (crho) crho->setVal(0.0);
+    // The Boundary pass adds to the current and charge
+    // deposited by the Interior pass
+    if (region != EvolveRegion::Boundary) {
+        jx.setVal(0.0);
+        jy.setVal(0.0);
+        jz.setVal(0.0);
+        if (cjx) cjx->setVal(0.0);
+        if (cjy) cjy->setVal(0.0);
+        if (cjz) cjz->setVal(0.0);
+        if (rho) rho->setVal(0.0);
+        if (crho) crho->setVal(0.0);
+    }
     for (auto& pc : allcontainers) {
 	pc->Evolve(lev, Ex, Ey, Ez, Bx, By, Bz, jx, jy, jz, cjx, cjy, cjz,
-               rho, crho, cEx, cEy, cEz, cBx, cBy, cBz, t, dt);
+               rho, crho, cEx, cEy, cEz, cBx, cBy, cBz, t, dt, region);
     }
 }
 
@@ -291,6 +318,14 @@ MultiParticleContainer::SortParticlesByCell ()
     }
 }
 
+void
+MultiParticleContainer::SortParticlesByBin (amrex::IntVect bin_size, bool interior_first)
+{
+    for (auto& pc : allcontainers) {
+        pc->SortParticlesByBin(bin_size, interior_first);
+    }
+}
+
 void
 MultiParticleContainer::Redistribute ()
 {
@@ -370,50 +405,8 @@ MultiParticleContainer
     for (int i = 0; i < nspecies_boosted_frame_diags; ++i){
         int isp = map_species_boosted_frame_diags[i];
         WarpXParticleContainer* pc = allcontainers[isp].get();
-        WarpXParticleContainer::DiagnosticParticles diagnostic_particles;
-        pc->GetParticleSlice(direction, z_old, z_new, t_boost, t_lab, dt, diagnostic_particles);
-        // Here, diagnostic_particles[lev][index] is a WarpXParticleContainer::DiagnosticParticleData
-        // where "lev" is the AMR level and "index" is a [grid index][tile index] pair.
-        
-        // Loop over AMR levels
-        for (int lev = 0; lev <= pc->finestLevel(); ++lev){
-            // Loop over [grid index][tile index] pairs 
-            // and Fills parts[species number i] with particle data from all grids and 
-            // tiles in diagnostic_particles. parts contains particles from all 
-            // AMR levels indistinctly.
-            for (auto it = diagnostic_particles[lev].begin(); it != diagnostic_particles[lev].end(); ++it){
-                // it->first is the [grid index][tile index] key
-                // it->second is the corresponding 
-                // WarpXParticleContainer::DiagnosticParticleData value
-                parts[i].GetRealData(DiagIdx::w).insert(  parts[i].GetRealData(DiagIdx::w  ).end(),
-                                                          it->second.GetRealData(DiagIdx::w  ).begin(),
-                                                          it->second.GetRealData(DiagIdx::w  ).end());
-                
-                parts[i].GetRealData(DiagIdx::x).insert(  parts[i].GetRealData(DiagIdx::x  ).end(),
-                                                          it->second.GetRealData(DiagIdx::x  ).begin(),
-                                                          it->second.GetRealData(DiagIdx::x  ).end());
-                
-                parts[i].GetRealData(DiagIdx::y).insert(  parts[i].GetRealData(DiagIdx::y  ).end(),
-                                                          it->second.GetRealData(DiagIdx::y  ).begin(),
-                                                          it->second.GetRealData(DiagIdx::y  ).end());
-                
-                parts[i].GetRealData(DiagIdx::z).insert(  parts[i].GetRealData(DiagIdx::z  ).end(),
-                                                          it->second.GetRealData(DiagIdx::z  ).begin(),
-                                                          it->second.GetRealData(DiagIdx::z  ).end());
-                
-                parts[i].GetRealData(DiagIdx::ux).insert(  parts[i].GetRealData(DiagIdx::ux).end(),
-                                                           it->second.GetRealData(DiagIdx::ux).begin(),
-                                                           it->second.GetRealData(DiagIdx::ux).end());
-                
-                parts[i].GetRealData(DiagIdx::uy).insert(  parts[i].GetRealData(DiagIdx::uy).end(),
-                                                           it->second.GetRealData(DiagIdx::uy).begin(),
-                                                           it->second.GetRealData(DiagIdx::uy).end());
-                
-                parts[i].GetRealData(DiagIdx::uz).insert(  parts[i].GetRealData(DiagIdx::uz).end(),
-                                                           it->second.GetRealData(DiagIdx::uz).begin(),
-                                                           it->second.GetRealData(DiagIdx::uz).end());
-            }
-        }
+        // parts[i] contains particles from all AMR levels indistinctly
+        pc->GetParticleSlice(direction, z_old, z_new, t_boost, t_lab, dt, parts[i]);
     }
 }
 
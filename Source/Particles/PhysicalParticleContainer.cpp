@@ -1,12 +1,16 @@
 #include <limits>
+#include <numeric>
 #include <sstream>
 
 #include <MultiParticleContainer.H>
 #include <WarpX_f.H>
 #include <WarpX.H>
 #include <WarpXConst.H>
+#include <CounterRNG.H>
 #include <WarpXWrappers.h>
 #include <FieldGather.H>
+#include <GetAndSetPosition.H>
+#include <FusedGatherPushDeposit.H>
 
 #include <WarpXAlgorithmSelection.H>
 
@@ -40,30 +44,51 @@ PhysicalParticleContainer::PhysicalParticleContainer (AmrCore* amr_core, int isp
     pp.query("plot_species", plot_species);
     int do_user_plot_vars;
     do_user_plot_vars = pp.queryarr("plot_vars", plot_vars);
+
+    // Whether to store the fields gathered on the particles as particle
+    // attributes. This is needed when they are written to plotfiles
+    // or accessed from Python; otherwise they are never stored.
+    pp.query("save_fields_on_particles", save_fields_on_particles);
+    if (do_user_plot_vars){
+        for (const auto& var : plot_vars){
+            for (const auto& name : ParticleStringNames::field_names){
+                if (var == name) save_fields_on_particles = 1;
+            }
+        }
+    }
+#ifdef WARPX_DO_ELECTROSTATIC
+    // The electrostatic push reads the fields from the particle attributes
+    save_fields_on_particles = 1;
+#endif
+
+    // The field attributes are added (in the MultiParticleContainer
+    // constructor) after the {x,y,z,ux,uy,uz}old attributes.
+    int ncomps = PIdx::nattribs;
+    if (WarpX::do_boosted_frame_diagnostic && do_boosted_frame_diags){
+        ncomps += 6;
+    }
+    if (save_fields_on_particles){
+        for (const auto& name : ParticleStringNames::field_names){
+            particle_comps[name] = ncomps++;
+        }
+    }
+
     if (not do_user_plot_vars){
         // By default, all particle variables are dumped to plotfiles,
         // including {x,y,z,ux,uy,uz}old variables when running in a 
-        // boosted frame
-        if (WarpX::do_boosted_frame_diagnostic && do_boosted_frame_diags){
-            plot_flags.resize(PIdx::nattribs + 6, 1);
-        } else {
-            plot_flags.resize(PIdx::nattribs, 1);
-        }
+        // boosted frame, and the fields when they are saved
+        plot_flags.resize(ncomps, 1);
     } else {
         // Set plot_flag to 0 for all attribs
-        if (WarpX::do_boosted_frame_diagnostic && do_boosted_frame_diags){
-            plot_flags.resize(PIdx::nattribs + 6, 0);
-        } else {
-            plot_flags.resize(PIdx::nattribs, 0);
-        }
+        plot_flags.resize(ncomps, 0);
         // If not none, set plot_flags values to 1 for elements in plot_vars.
         if (plot_vars[0] != "none"){
             for (const auto& var : plot_vars){
-                // Return error if var not in PIdx. 
+                // Return error if var is not a particle attribute.
                 AMREX_ALWAYS_ASSERT_WITH_MESSAGE( 
-                    ParticleStringNames::to_index.count(var), 
-                    "plot_vars argument not in ParticleStringNames");
-                plot_flags[ParticleStringNames::to_index.at(var)] = 1;
+                    particle_comps.count(var), 
+                    "plot_vars argument is not a particle attribute");
+                plot_flags[particle_comps.at(var)] = 1;
             }
         }
     }
@@ -133,83 +158,139 @@ PhysicalParticleContainer::AddGaussianBeam(Real x_m, Real y_m, Real z_m,
                                            Real q_tot, long npart, 
                                            int do_symmetrize) {
 
-    const Geometry& geom     = m_gdb->Geom(0);
-    RealBox containing_bx = geom.ProbDomain();
+    BL_PROFILE("PhysicalParticleContainer::AddGaussianBeam");
 
-    std::mt19937_64 mt(0451);
-    std::normal_distribution<double> distx(x_m, x_rms);
-    std::normal_distribution<double> disty(y_m, y_rms);
-    std::normal_distribution<double> distz(z_m, z_rms);
+    // Each rank draws its own share of the particle indices, with a
+    // counter-based generator keyed on the particle index: the beam does
+    // not depend on the number of ranks and threads, and no particle goes
+    // through rank 0. The particles are then appended to the tiles that
+    // own them by AddNParticles.
+    const int lev = 0;
+    const Geometry& geom = Geom(lev);
+    const Box& domain = geom.Domain();
+    const auto dxi = geom.InvCellSizeArray();
+    const auto problo = geom.ProbLoArray();
+    const std::uint64_t seed = plasma_injector->random_seed;
 
-    if (ParallelDescriptor::IOProcessor()) {
-        // If do_symmetrize, create 4x fewer particles, and 
-        // Replicate each particle 4 times (x,y) (-x,y) (x,-y) (-x,-y)
-        if (do_symmetrize){
-            npart /= 4;
-        }
-        for (long i = 0; i < npart; ++i) {
+    // If do_symmetrize, create 4x fewer particles, and 
+    // Replicate each particle 4 times (x,y) (x,-y) (-x,y) (-x,-y)
+    if (do_symmetrize){
+        npart /= 4;
+    }
+    const int nmirror = do_symmetrize ? 4 : 1;
 #if ( AMREX_SPACEDIM == 3 | WARPX_DIM_RZ)
-            Real weight = q_tot/npart/charge;
-            Real x = distx(mt);
-            Real y = disty(mt);
-            Real z = distz(mt);
+    const Real weight = q_tot/npart/charge/nmirror;
 #elif ( AMREX_SPACEDIM == 2 )
-            Real weight = q_tot/npart/charge/y_rms;
-            Real x = distx(mt);
-            Real y = 0.;
-            Real z = distz(mt);
+    const Real weight = q_tot/npart/charge/y_rms/nmirror;
 #endif
-            if (plasma_injector->insideBounds(x, y, z)) {
-                XDim3 u = plasma_injector->getMomentum(x, y, z);
-                u.x *= PhysConst::c;
-                u.y *= PhysConst::c;
-                u.z *= PhysConst::c;
-                if (do_symmetrize){
-                    // Add four particles to the beam:
-                    CheckAndAddParticle( x, y, z, { u.x, u.y, u.z}, weight/4. );
-                    CheckAndAddParticle( x,-y, z, { u.x,-u.y, u.z}, weight/4. );
-                    CheckAndAddParticle(-x, y, z, {-u.x, u.y, u.z}, weight/4. );
-                    CheckAndAddParticle(-x,-y, z, {-u.x,-u.y, u.z}, weight/4. );
-                } else {
-                    CheckAndAddParticle(x, y, z, {u.x,u.y,u.z}, weight);
+
+    // Range [ibegin, iend) of the indices drawn by this rank
+    const int myproc = ParallelDescriptor::MyProc();
+    const int nprocs = ParallelDescriptor::NProcs();
+    const long navg = npart/nprocs;
+    const long nleft = npart - navg*nprocs;
+    const long ibegin = (myproc < nleft) ? myproc*(navg+1) : myproc*navg + nleft;
+    const long iend = ibegin + ((myproc < nleft) ? navg+1 : navg);
+
+    struct BeamParticle {
+        Real x, y, z;
+        std::array<Real,3> u;
+    };
+#ifdef _OPENMP
+    Vector<Vector<BeamParticle> > found(omp_get_max_threads());
+#else
+    Vector<Vector<BeamParticle> > found(1);
+#endif
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+#ifdef _OPENMP
+        Vector<BeamParticle>& my_found = found[omp_get_thread_num()];
+#else
+        Vector<BeamParticle>& my_found = found[0];
+#endif
+        // With a static schedule, each thread handles a contiguous range
+        // of indices, so the particles end up sorted by index.
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+        for (long i = ibegin; i < iend; ++i) {
+            Real n[6];
+            CounterRNG::normal2(seed, i, 0, n[0], n[1]);
+            CounterRNG::normal2(seed, i, 1, n[2], n[3]);
+            CounterRNG::normal2(seed, i, 2, n[4], n[5]);
+#if ( AMREX_SPACEDIM == 3 | WARPX_DIM_RZ)
+            const Real x = x_m + x_rms*n[0];
+            const Real y = y_m + y_rms*n[1];
+            const Real z = z_m + z_rms*n[2];
+#elif ( AMREX_SPACEDIM == 2 )
+            const Real x = x_m + x_rms*n[0];
+            const Real y = 0.;
+            const Real z = z_m + z_rms*n[2];
+#endif
+            if (!plasma_injector->insideBounds(x, y, z)) continue;
+
+            XDim3 u = plasma_injector->getMomentum(x, y, z, XDim3{n[3], n[4], n[5]});
+            u.x *= PhysConst::c;
+            u.y *= PhysConst::c;
+            u.z *= PhysConst::c;
+
+            for (int k = 0; k < nmirror; ++k) {
+                const Real sx = (k & 2) ? -1. : 1.;
+                const Real sy = (k & 1) ? -1. : 1.;
+                Real xk = sx*x;
+                Real yk = sy*y;
+                Real zk = z;
+                std::array<Real,3> uk = {sx*u.x, sy*u.y, u.z};
+                if (WarpX::gamma_boost > 1.) {
+                    MapParticletoBoostedFrame(xk, yk, zk, uk);
                 }
+                // Particles outside of the domain are not injected, even
+                // across a periodic boundary
+#if (AMREX_SPACEDIM == 3)
+                const IntVect iv(static_cast<int>(std::floor((xk-problo[0])*dxi[0])),
+                                 static_cast<int>(std::floor((yk-problo[1])*dxi[1])),
+                                 static_cast<int>(std::floor((zk-problo[2])*dxi[2])));
+#elif defined WARPX_DIM_RZ
+                const IntVect iv(static_cast<int>(std::floor((std::sqrt(xk*xk+yk*yk)-problo[0])*dxi[0])),
+                                 static_cast<int>(std::floor((zk-problo[1])*dxi[1])));
+#else
+                const IntVect iv(static_cast<int>(std::floor((xk-problo[0])*dxi[0])),
+                                 static_cast<int>(std::floor((zk-problo[1])*dxi[1])));
+#endif
+                if (!domain.contains(iv)) continue;
+                my_found.push_back({xk, yk, zk, uk});
             }
         }
     }
-    Redistribute();
-}
-
-void
-PhysicalParticleContainer::CheckAndAddParticle(Real x, Real y, Real z,
-                                               std::array<Real, 3> u,
-                                               Real weight)
-{
-    std::array<Real,PIdx::nattribs> attribs;
-    attribs.fill(0.0);
-
-    // update attribs with input arguments
-    if (WarpX::gamma_boost > 1.) {
-        MapParticletoBoostedFrame(x, y, z, u);
-    }
-    attribs[PIdx::ux] = u[0];
-    attribs[PIdx::uy] = u[1];
-    attribs[PIdx::uz] = u[2];
-    attribs[PIdx::w ] = weight;
 
-    if (WarpX::do_boosted_frame_diagnostic && do_boosted_frame_diags)
-    {
-        // need to create old values
-        auto& particle_tile = DefineAndReturnParticleTile(0, 0, 0);
-        particle_tile.push_back_real(particle_comps["xold"], x);
-        particle_tile.push_back_real(particle_comps["yold"], y);
-        particle_tile.push_back_real(particle_comps["zold"], z);
-                
-        particle_tile.push_back_real(particle_comps["uxold"], u[0]);
-        particle_tile.push_back_real(particle_comps["uyold"], u[1]);
-        particle_tile.push_back_real(particle_comps["uzold"], u[2]);
+    // Append all the particles of this rank at once: they are sent to the
+    // tiles (and ranks) that own them by RedistributeNew.
+    long np = 0;
+    for (auto const& particles : found) np += particles.size();
+    Vector<Real> xp, yp, zp, uxp, uyp, uzp;
+    xp.reserve(np);
+    yp.reserve(np);
+    zp.reserve(np);
+    uxp.reserve(np);
+    uyp.reserve(np);
+    uzp.reserve(np);
+    for (auto const& particles : found) {
+        for (auto const& p : particles) {
+            xp.push_back(p.x);
+            yp.push_back(p.y);
+            zp.push_back(p.z);
+            uxp.push_back(p.u[0]);
+            uyp.push_back(p.u[1]);
+            uzp.push_back(p.u[2]);
+        }
     }
-    // add particle
-    AddOneParticle(0, 0, 0, x, y, z, attribs);
+    const Vector<Real> wp(np, weight);
+    AddNParticles(lev, static_cast<int>(np), xp.dataPtr(), yp.dataPtr(), zp.dataPtr(),
+                  uxp.dataPtr(), uyp.dataPtr(), uzp.dataPtr(),
+                  1, wp.dataPtr(), 1);
 }
 
 void
@@ -298,9 +379,9 @@ PhysicalParticleContainer::AddPlasma (int lev, RealBox part_realbox)
     MultiFab* cost = WarpX::getCosts(lev);
 
     const int nlevs = numLevels();
-    static bool refine_injection = false;
-    static Box fine_injection_box;
-    static int rrfac = 1;
+    bool refine_injection = false;
+    Box fine_injection_box;
+    int rrfac = 1;
     // This does not work if the mesh is dynamic.  But in that case, we should
     // not use refined injected either.  We also assume there is only one fine level.
     if (WarpX::do_moving_window and WarpX::refine_plasma
@@ -327,6 +408,16 @@ PhysicalParticleContainer::AddPlasma (int lev, RealBox part_realbox)
     bool radially_weighted = plasma_injector->radially_weighted;
 #endif
 
+    // The random numbers of a candidate particle are a function of this key,
+    // of its cell and of its index in the cell, so that the count pass and
+    // the fill pass below see the same particle.
+    const std::uint64_t rng_key = (static_cast<std::uint64_t>(species_id) << 32)
+        | static_cast<std::uint32_t>(add_plasma_calls++);
+
+    // The IDs of the new particles are reserved in one block per tile
+    int next_id = ParticleType::NextID();
+    const int cpuid = ParallelDescriptor::MyProc();
+
     MFItInfo info;
     if (do_tiling && Gpu::notInLaunchRegion()) {
         info.EnableTiling(tile_size);
@@ -377,155 +468,93 @@ PhysicalParticleContainer::AddPlasma (int lev, RealBox part_realbox)
         const int grid_id = mfi.index();
         const int tile_id = mfi.LocalTileIndex();
 
-        // Max number of new particles, if particles are created in the whole
-        // overlap_box. All of them are created, and invalid ones are then 
-        // discaded
-        int max_new_particles = overlap_box.numPts() * num_ppc;
-
-        // If refine injection, build pointer dp_cellid that holds pointer to 
-        // array of refined cell IDs.
-        Vector<int> cellid_v;
-        if (refine_injection and lev == 0)
-        {
-            // then how many new particles will be injected is not that simple
-            // We have to shift fine_injection_box because overlap_box has been shifted.
-            Box fine_overlap_box = overlap_box & amrex::shift(fine_injection_box,shifted);
-            max_new_particles += fine_overlap_box.numPts() * num_ppc
-                * (AMREX_D_TERM(rrfac,*rrfac,*rrfac)-1);
-            for (int icell = 0, ncells = overlap_box.numPts(); icell < ncells; ++icell) {
-                IntVect iv = overlap_box.atOffset(icell);
-                int r = (fine_overlap_box.contains(iv)) ? AMREX_D_TERM(rrfac,*rrfac,*rrfac) : 1;
-                for (int ipart = 0; ipart < r; ++ipart) {
-                    cellid_v.push_back(icell);
-                    cellid_v.push_back(ipart);
-                }
-            }
-        }
-        int const* hp_cellid = (cellid_v.empty()) ? nullptr : cellid_v.data();
-        amrex::AsyncArray<int> cellid_aa(hp_cellid, cellid_v.size());
-        int const* dp_cellid = cellid_aa.data();
-
-        // Update NextID to include particles created in this function
-        int pid;
-#pragma omp critical (add_plasma_nextid)
-        {
-            pid = ParticleType::NextID();
-            ParticleType::NextID(pid+max_new_particles);
-        }
-        const int cpuid = ParallelDescriptor::MyProc();
-
-        auto& particle_tile = GetParticles(lev)[std::make_pair(grid_id,tile_id)];
-        bool do_boosted = false;
-        if (WarpX::do_boosted_frame_diagnostic && do_boosted_frame_diags) {
-            do_boosted = true;
-            DefineAndReturnParticleTile(lev, grid_id, tile_id);
-        }
-        auto old_size = particle_tile.GetArrayOfStructs().size();
-        auto new_size = old_size + max_new_particles;
-        particle_tile.resize(new_size);
-
-        ParticleType* pp = particle_tile.GetArrayOfStructs()().data() + old_size;
-        auto& soa = particle_tile.GetStructOfArrays();
-        GpuArray<Real*,PIdx::nattribs> pa;
-        for (int ia = 0; ia < PIdx::nattribs; ++ia) {
-            pa[ia] = soa.GetRealData(ia).data() + old_size;
-        }
-        GpuArray<Real*,6> pb;
-        if (do_boosted) {
-            pb[0] = soa.GetRealData(particle_comps[ "xold"]).data() + old_size;
-            pb[1] = soa.GetRealData(particle_comps[ "yold"]).data() + old_size;
-            pb[2] = soa.GetRealData(particle_comps[ "zold"]).data() + old_size;
-            pb[3] = soa.GetRealData(particle_comps["uxold"]).data() + old_size;
-            pb[4] = soa.GetRealData(particle_comps["uyold"]).data() + old_size;
-            pb[5] = soa.GetRealData(particle_comps["uzold"]).data() + old_size;
+        // With refined injection, the cells of fine_overlap_box get
+        // rrfac**AMREX_SPACEDIM times more candidate particles.
+        // We have to shift fine_injection_box because overlap_box has been shifted.
+        Box fine_overlap_box;
+        if (refine_injection and lev == 0) {
+            fine_overlap_box = overlap_box & amrex::shift(fine_injection_box,shifted);
         }
+        const int fine_ppc = num_ppc * AMREX_D_TERM(rrfac,*rrfac,*rrfac);
+        const int lrrfac = rrfac;
 
         const GpuArray<Real,AMREX_SPACEDIM> overlap_corner
             {AMREX_D_DECL(overlap_realbox.lo(0),
                           overlap_realbox.lo(1),
                           overlap_realbox.lo(2))};
 
-        std::size_t shared_mem_bytes = plasma_injector->sharedMemoryNeeded();
-        int lrrfac = rrfac;
-
-        // Loop over all new particles and inject them (creates too many 
-        // particles, in particular does not consider xmin, xmax etc.).
-        // The invalid ones are given negative ID and are deleted during the 
-        // next redistribute.
-        amrex::For(max_new_particles, [=] AMREX_GPU_DEVICE (int ip) noexcept
+        // Evaluate candidate particle i_part of cell cellid of overlap_box.
+        // Returns false if the candidate is rejected (outside of the tile or
+        // of the species bounds, or below density_min). The momentum and
+        // weight are only computed when do_fill is true.
+        auto make_particle = [=] AMREX_GPU_HOST_DEVICE (
+            int cellid, int i_part, bool do_fill,
+            Real& x, Real& y, Real& z, Real& xb, Real& theta,
+            XDim3& u, Real& weight) noexcept -> bool
         {
-            ParticleType& p = pp[ip];
-            p.id() = pid+ip;
-            p.cpu() = cpuid;
-
-            int cellid, i_part;
-            Real fac;
-            if (dp_cellid == nullptr) {
-                cellid = ip/num_ppc;
-                i_part = ip - cellid*num_ppc;
-                fac = 1.0;
-            } else {
-                cellid = dp_cellid[2*ip];
-                i_part = dp_cellid[2*ip+1];
-                fac = lrrfac;
+            const IntVect iv = overlap_box.atOffset(cellid);
+            const int fac = fine_overlap_box.contains(iv) ? lrrfac : 1;
+
+            // Counter of the random numbers: the global index of the cell
+            std::uint64_t counter = 0;
+            for (int dir=0; dir<AMREX_SPACEDIM; dir++) {
+                counter |= (static_cast<std::uint64_t>(shifted[dir]+iv[dir]) & 0x1FFFFF)
+                    << (21*dir);
             }
-
-            IntVect iv = overlap_box.atOffset(cellid);
-
-            const XDim3 r = inj_pos->getPositionUnitBox(i_part, fac);
+            std::uint32_t rn[4];
+            CounterRNG::philox4x32(rng_key, counter, 4*i_part, rn);
+            const Real ru_x = CounterRNG::uniform(rn[0], rn[1]);
+            const Real ru_y = CounterRNG::uniform(rn[2], rn[3]);
+            CounterRNG::philox4x32(rng_key, counter, 4*i_part+1, rn);
+            const Real ru_z = CounterRNG::uniform(rn[0], rn[1]);
+
+            const XDim3 r = inj_pos->getPositionUnitBox(i_part, fac, XDim3{ru_x, ru_y, ru_z});
 #if (AMREX_SPACEDIM == 3)
-            Real x = overlap_corner[0] + (iv[0]+r.x)*dx[0];
-            Real y = overlap_corner[1] + (iv[1]+r.y)*dx[1];
-            Real z = overlap_corner[2] + (iv[2]+r.z)*dx[2];
+            x = overlap_corner[0] + (iv[0]+r.x)*dx[0];
+            y = overlap_corner[1] + (iv[1]+r.y)*dx[1];
+            z = overlap_corner[2] + (iv[2]+r.z)*dx[2];
+            if (!tile_realbox.contains(XDim3{x,y,z})) return false;
 #else
-            Real x = overlap_corner[0] + (iv[0]+r.x)*dx[0];
-            Real y = 0.0;
-            Real z = overlap_corner[1] + (iv[1]+r.y)*dx[1];
-#endif
-
-#if (AMREX_SPACEDIM == 3)
-            if (!tile_realbox.contains(XDim3{x,y,z})) {
-                p.id() = -1;
-                return;
-            }
-#else
-            if (!tile_realbox.contains(XDim3{x,z,0.0})) {
-                p.id() = -1;
-                return;
-            }
+            x = overlap_corner[0] + (iv[0]+r.x)*dx[0];
+            y = 0.0;
+            z = overlap_corner[1] + (iv[1]+r.y)*dx[1];
+            if (!tile_realbox.contains(XDim3{x,z,0.0})) return false;
 #endif
 
             // Save the x and y values to use in the insideBounds checks.
             // This is needed with WARPX_DIM_RZ since x and y are modified.
-            Real xb = x;
+            xb = x;
             Real yb = y;
 
+            theta = 0.0;
 #ifdef WARPX_DIM_RZ
             // Replace the x and y, choosing the angle randomly.
             // These x and y are used to get the momentum and density
-            Real theta = 2.*MathConst::pi*amrex::Random();
+            theta = 2.*MathConst::pi*CounterRNG::uniform(rn[2], rn[3]);
             x = xb*std::cos(theta);
             y = xb*std::sin(theta);
 #endif
 
+            // Standard normal deviates for random momentum distributions
+            XDim3 rm{0.0, 0.0, 0.0};
+            if (do_fill or gamma_boost != 1.) {
+                Real rm_unused;
+                CounterRNG::normal2(rng_key, counter, 4*i_part+2, rm.x, rm.y);
+                CounterRNG::normal2(rng_key, counter, 4*i_part+3, rm.z, rm_unused);
+            }
+
             Real dens;
-            XDim3 u;
             if (gamma_boost == 1.) {
                 // Lab-frame simulation
                 // If the particle is not within the species's
                 // xmin, xmax, ymin, ymax, zmin, zmax, go to
                 // the next generated particle.
-                if (!inj_pos->insideBounds(xb, yb, z)) {
-                    p.id() = -1;
-                    return;
-                }
-                u = inj_mom->getMomentum(x, y, z);
+                if (!inj_pos->insideBounds(xb, yb, z)) return false;
                 dens = inj_rho->getDensity(x, y, z);
                 // Remove particle if density below threshold
-                if ( dens < density_min ){
-                    p.id() = -1;
-                    return;
-                }
+                if ( dens < density_min ) return false;
+                if (!do_fill) return true;
+                u = inj_mom->getMomentum(x, y, z, rm);
                 // Cut density if above threshold
                 dens = amrex::min(dens, density_max);
             } else {
@@ -540,7 +569,7 @@ PhysicalParticleContainer::AddPlasma (int lev, RealBox part_realbox)
                 //
                 // In order for this equation to be solvable, betaz_lab
                 // is explicitly assumed to have no dependency on z0_lab
-                u = inj_mom->getMomentum(x, y, 0.); // No z0_lab dependency
+                u = inj_mom->getMomentum(x, y, 0., rm); // No z0_lab dependency
                 // At this point u is the lab-frame momentum
                 // => Apply the above formula for z0_lab
                 Real gamma_lab = std::sqrt( 1.+(u.x*u.x+u.y*u.y+u.z*u.z) );
@@ -549,17 +578,12 @@ PhysicalParticleContainer::AddPlasma (int lev, RealBox part_realbox)
                                               - PhysConst::c*t*(betaz_lab-beta_boost) );
                 // If the particle is not within the lab-frame zmin, zmax, etc.
                 // go to the next generated particle.
-                if (!inj_pos->insideBounds(xb, yb, z0_lab)) {
-                    p.id() = -1;
-                    return;
-                }
+                if (!inj_pos->insideBounds(xb, yb, z0_lab)) return false;
                 // call `getDensity` with lab-frame parameters
                 dens = inj_rho->getDensity(x, y, z0_lab);
                 // Remove particle if density below threshold
-                if ( dens < density_min ){
-                    p.id() = -1;
-                    return;
-                }
+                if ( dens < density_min ) return false;
+                if (!do_fill) return true;
                 // Cut density if above threshold
                 dens = amrex::min(dens, density_max);
                 // At this point u and dens are the lab-frame quantities
@@ -572,8 +596,8 @@ PhysicalParticleContainer::AddPlasma (int lev, RealBox part_realbox)
             u.y *= PhysConst::c;
             u.z *= PhysConst::c;
 
-            // Real weight = dens * scale_fac / (AMREX_D_TERM(fac, *fac, *fac));
-            Real weight = dens * scale_fac;
+            // weight = dens * scale_fac / (AMREX_D_TERM(fac, *fac, *fac));
+            weight = dens * scale_fac;
 #ifdef WARPX_DIM_RZ
             if (radially_weighted) {
                 weight *= 2.*MathConst::pi*xb;
@@ -584,33 +608,119 @@ PhysicalParticleContainer::AddPlasma (int lev, RealBox part_realbox)
                 weight *= dx[0];
             }
 #endif
-            pa[PIdx::w ][ip] = weight;
-            pa[PIdx::ux][ip] = u.x;
-            pa[PIdx::uy][ip] = u.y;
-            pa[PIdx::uz][ip] = u.z;
+            return true;
+        };
+
+        // The parser profiles need shared memory on GPU, in both passes
+        std::size_t shared_mem_bytes = plasma_injector->sharedMemoryNeeded();
+
+        // Count pass: number of surviving particles in each cell, then
+        // exclusive prefix sum, so that offsets[cellid] is the index of the
+        // first particle of cell cellid.
+        const int ncells = overlap_box.numPts();
+        Gpu::ManagedDeviceVector<int> offsets(ncells+1, 0);
+        int* const poffsets = offsets.dataPtr();
+        amrex::For(ncells, [=] AMREX_GPU_DEVICE (int cellid) noexcept
+        {
+            const int npc = fine_overlap_box.contains(overlap_box.atOffset(cellid))
+                ? fine_ppc : num_ppc;
+            int count = 0;
+            for (int i_part = 0; i_part < npc; ++i_part) {
+                Real x, y, z, xb, theta, weight;
+                XDim3 u;
+                if (make_particle(cellid, i_part, false, x, y, z, xb, theta, u, weight)) {
+                    ++count;
+                }
+            }
+            poffsets[cellid+1] = count;
+        }, shared_mem_bytes);
+        Gpu::Device::synchronize();
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+        const int num_new_particles = offsets[ncells];
+
+        if (num_new_particles > 0)
+        {
+            int pid;
+#ifdef _OPENMP
+#pragma omp atomic capture
+#endif
+            { pid = next_id; next_id += num_new_particles; }
 
+            auto& particle_tile = GetParticles(lev)[std::make_pair(grid_id,tile_id)];
+            bool do_boosted = false;
+            if (WarpX::do_boosted_frame_diagnostic && do_boosted_frame_diags) {
+                do_boosted = true;
+                DefineAndReturnParticleTile(lev, grid_id, tile_id);
+            }
+            auto old_size = particle_tile.GetArrayOfStructs().size();
+            auto new_size = old_size + num_new_particles;
+            particle_tile.resize(new_size);
+
+            ParticleType* pp = particle_tile.GetArrayOfStructs()().data() + old_size;
+            auto& soa = particle_tile.GetStructOfArrays();
+            GpuArray<Real*,PIdx::nattribs> pa;
+            for (int ia = 0; ia < PIdx::nattribs; ++ia) {
+                pa[ia] = soa.GetRealData(ia).data() + old_size;
+            }
+            GpuArray<Real*,6> pb;
             if (do_boosted) {
-                pb[0][ip] = x;
-                pb[1][ip] = y;
-                pb[2][ip] = z;
-                pb[3][ip] = u.x;
-                pb[4][ip] = u.y;
-                pb[5][ip] = u.z;
+                pb[0] = soa.GetRealData(particle_comps[ "xold"]).data() + old_size;
+                pb[1] = soa.GetRealData(particle_comps[ "yold"]).data() + old_size;
+                pb[2] = soa.GetRealData(particle_comps[ "zold"]).data() + old_size;
+                pb[3] = soa.GetRealData(particle_comps["uxold"]).data() + old_size;
+                pb[4] = soa.GetRealData(particle_comps["uyold"]).data() + old_size;
+                pb[5] = soa.GetRealData(particle_comps["uzold"]).data() + old_size;
             }
 
+            // Fill pass: evaluate the candidates again, and write the
+            // surviving ones of each cell from offsets[cellid] on.
+            amrex::For(ncells, [=] AMREX_GPU_DEVICE (int cellid) noexcept
+            {
+                const int npc = fine_overlap_box.contains(overlap_box.atOffset(cellid))
+                    ? fine_ppc : num_ppc;
+                int ip = poffsets[cellid];
+                for (int i_part = 0; i_part < npc; ++i_part)
+                {
+                    Real x, y, z, xb, theta, weight;
+                    XDim3 u;
+                    if (!make_particle(cellid, i_part, true, x, y, z, xb, theta, u, weight)) {
+                        continue;
+                    }
+
+                    ParticleType& p = pp[ip];
+                    p.id() = pid+ip;
+                    p.cpu() = cpuid;
+
+                    pa[PIdx::w ][ip] = weight;
+                    pa[PIdx::ux][ip] = u.x;
+                    pa[PIdx::uy][ip] = u.y;
+                    pa[PIdx::uz][ip] = u.z;
+
+                    if (do_boosted) {
+                        pb[0][ip] = x;
+                        pb[1][ip] = y;
+                        pb[2][ip] = z;
+                        pb[3][ip] = u.x;
+                        pb[4][ip] = u.y;
+                        pb[5][ip] = u.z;
+                    }
+
 #if (AMREX_SPACEDIM == 3)
-            p.pos(0) = x;
-            p.pos(1) = y;
-            p.pos(2) = z;
+                    p.pos(0) = x;
+                    p.pos(1) = y;
+                    p.pos(2) = z;
 #elif (AMREX_SPACEDIM == 2)
 #ifdef WARPX_DIM_RZ
-            pa[PIdx::theta][ip] = theta;
+                    pa[PIdx::theta][ip] = theta;
 #endif
-            p.pos(0) = xb;
-            p.pos(1) = z;
+                    p.pos(0) = xb;
+                    p.pos(1) = z;
 #endif
-        }, shared_mem_bytes);
-    			 
+                    ++ip;
+                }
+            }, shared_mem_bytes);
+        }
+
         if (cost) {
             wt = (amrex::second() - wt) / tile_box.d_numPts();
             Array4<Real> const& costarr = cost->array(mfi);
@@ -622,6 +732,8 @@ PhysicalParticleContainer::AddPlasma (int lev, RealBox part_realbox)
         }
     }
 
+    ParticleType::NextID(next_id);
+
     // The function that calls this is responsible for redistributing particles.
 }
 
@@ -655,10 +767,10 @@ FieldGatherES (const amrex::Vector<std::array<std::unique_ptr<amrex::MultiFab>,
             int nstride = particles.dataShape().first;
             const long np  = pti.numParticles();
             auto& attribs = pti.GetAttribs();
-            auto& Exp = attribs[PIdx::Ex];
-            auto& Eyp = attribs[PIdx::Ey];
+            auto& Exp = pti.GetAttribs(particle_comps["Ex"]);
+            auto& Eyp = pti.GetAttribs(particle_comps["Ey"]);
 #if AMREX_SPACEDIM == 3
-            auto& Ezp = attribs[PIdx::Ez];
+            auto& Ezp = pti.GetAttribs(particle_comps["Ez"]);
 #endif
             Exp.assign(np,0.0);
             Eyp.assign(np,0.0);
@@ -724,10 +836,10 @@ FieldGatherES (const amrex::Vector<std::array<std::unique_ptr<amrex::MultiFab>,
             const long np  = pti.numParticles();
 
             auto& attribs = pti.GetAttribs();
-            auto& Exp = attribs[PIdx::Ex];
-            auto& Eyp = attribs[PIdx::Ey];
+            auto& Exp = pti.GetAttribs(particle_comps["Ex"]);
+            auto& Eyp = pti.GetAttribs(particle_comps["Ey"]);
 #if AMREX_SPACEDIM == 3
-            auto& Ezp = attribs[PIdx::Ez];
+            auto& Ezp = pti.GetAttribs(particle_comps["Ez"]);
 #endif
             Exp.assign(np,0.0);
             Eyp.assign(np,0.0);
@@ -811,11 +923,11 @@ PhysicalParticleContainer::EvolveES (const Vector<std::array<std::unique_ptr<Mul
             auto& uzp = attribs[PIdx::uz];
 #endif
 
-            auto& Exp = attribs[PIdx::Ex];
-            auto& Eyp = attribs[PIdx::Ey];
+            auto& Exp = pti.GetAttribs(particle_comps["Ex"]);
+            auto& Eyp = pti.GetAttribs(particle_comps["Ey"]);
 
 #if AMREX_SPACEDIM == 3
-            auto& Ezp = attribs[PIdx::Ez];
+            auto& Ezp = pti.GetAttribs(particle_comps["Ez"]);
 #endif
             //
             // Particle Push
@@ -864,12 +976,14 @@ PhysicalParticleContainer::FieldGather (int lev,
 
             auto& attribs = pti.GetAttribs();
 
-            auto& Exp = attribs[PIdx::Ex];
-            auto& Eyp = attribs[PIdx::Ey];
-            auto& Ezp = attribs[PIdx::Ez];
-            auto& Bxp = attribs[PIdx::Bx];
-            auto& Byp = attribs[PIdx::By];
-            auto& Bzp = attribs[PIdx::Bz];
+            // Fields on particles: attributes if saved, scratch otherwise
+            auto fields = GetFieldsOnParticles(pti, thread_num);
+            auto& Exp = *fields[0];
+            auto& Eyp = *fields[1];
+            auto& Ezp = *fields[2];
+            auto& Bxp = *fields[3];
+            auto& Byp = *fields[4];
+            auto& Bzp = *fields[5];
 
             const long np = pti.numParticles();
 
@@ -888,11 +1002,6 @@ PhysicalParticleContainer::FieldGather (int lev,
             Byp.assign(np,0.0);
             Bzp.assign(np,0.0);
 
-            //
-            // copy data from particle container to temp arrays
-            //
-            pti.GetPosition(m_xp[thread_num], m_yp[thread_num], m_zp[thread_num]);
-
             //
             // Field Gather
             //
@@ -924,13 +1033,14 @@ PhysicalParticleContainer::Evolve (int lev,
                                    MultiFab* rho, MultiFab* crho,
                                    const MultiFab* cEx, const MultiFab* cEy, const MultiFab* cEz,
                                    const MultiFab* cBx, const MultiFab* cBy, const MultiFab* cBz,
-                                   Real t, Real dt)
+                                   Real t, Real dt, EvolveRegion region)
 {
     BL_PROFILE("PPC::Evolve()");
     BL_PROFILE_VAR_NS("PPC::Evolve::Copy", blp_copy);
     BL_PROFILE_VAR_NS("PICSAR::FieldGather", blp_pxr_fg);
     BL_PROFILE_VAR_NS("PPC::ParticlePush", blp_ppc_pp);
     BL_PROFILE_VAR_NS("PPC::Evolve::partition", blp_partition);
+    BL_PROFILE_VAR_NS("PPC::GatherPushDeposit", blp_fused);
     
     const std::array<Real,3>& dx = WarpX::CellSize(lev);
     const std::array<Real,3>& cdx = WarpX::CellSize(std::max(lev-1,0));
@@ -948,6 +1058,30 @@ PhysicalParticleContainer::Evolve (int lev,
 
     bool has_buffer = cEx || cjx;
 
+    // The fused kernel gathers the fields, pushes the particles and
+    // deposits the current in a single pass over the particles.
+    // It does not handle the gather and deposition buffers.
+    const bool fused = WarpX::fused_gather_push_deposit &&
+        allow_fused_gather_push_deposit && !has_buffer && !do_not_push;
+
+    // When the exchange of the guard cells of E and B overlaps with the push,
+    // species that can only be evolved tile by tile (fused kernel, buffers,
+    // filtered fields) are entirely evolved in the Boundary pass,
+    // i.e. once the exchange is complete
+    if (region != EvolveRegion::All &&
+        (fused || has_buffer || do_not_push || WarpX::use_fdtd_nci_corr)) {
+        if (region == EvolveRegion::Interior) return;
+        region = EvolveRegion::All;
+    }
+    if (region == EvolveRegion::Interior) {
+        // Insert all the tiles beforehand, so that the
+        // threads below only modify existing entries
+        n_interior_particles.clear();
+        for (const auto& kv : GetParticles(lev)) {
+            n_interior_particles[kv.first] = 0;
+        }
+    }
+
 #ifdef _OPENMP
 #pragma omp parallel 
 #endif
@@ -963,6 +1097,7 @@ PhysicalParticleContainer::Evolve (int lev,
         std::vector<bool> inexflag;
         Vector<long> pid;
         RealVector tmp;
+        IntVector int_tmp;
         ParticleVector particle_tmp;
 
         for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
@@ -977,12 +1112,14 @@ PhysicalParticleContainer::Evolve (int lev,
             auto& uxp = attribs[PIdx::ux];
             auto& uyp = attribs[PIdx::uy];
             auto& uzp = attribs[PIdx::uz];
-            auto& Exp = attribs[PIdx::Ex];
-            auto& Eyp = attribs[PIdx::Ey];
-            auto& Ezp = attribs[PIdx::Ez];
-            auto& Bxp = attribs[PIdx::Bx];
-            auto& Byp = attribs[PIdx::By];
-            auto& Bzp = attribs[PIdx::Bz];
+            // Fields on particles: attributes if saved, scratch otherwise
+            auto fields = GetFieldsOnParticles(pti, thread_num);
+            auto& Exp = *fields[0];
+            auto& Eyp = *fields[1];
+            auto& Ezp = *fields[2];
+            auto& Bxp = *fields[3];
+            auto& Byp = *fields[4];
+            auto& Bzp = *fields[5];
 
             const long np = pti.numParticles();
 
@@ -1047,14 +1184,65 @@ PhysicalParticleContainer::Evolve (int lev,
 #endif
             }
 
-            Exp.assign(np,0.0);
-            Eyp.assign(np,0.0);
-            Ezp.assign(np,0.0);
-            Bxp.assign(np,WarpX::B_external[0]);
-            Byp.assign(np,WarpX::B_external[1]);
-            Bzp.assign(np,WarpX::B_external[2]);
+            // Range [p_offset, p_offset+p_count) of the particles
+            // of the tile that are evolved by this call
+            long p_offset = 0;
+            long p_count = np;
+            const auto tile_key = std::make_pair(pti.index(), pti.LocalTileIndex());
+            if (region == EvolveRegion::Interior) {
+                BL_PROFILE_VAR_START(blp_partition);
+                p_count = PartitionInteriorParticles(pti, lev, pid, particle_tmp, tmp, int_tmp);
+                n_interior_particles.at(tile_key) = p_count;
+                BL_PROFILE_VAR_STOP(blp_partition);
+            } else if (region == EvolveRegion::Boundary) {
+                p_offset = n_interior_particles.at(tile_key);
+                p_count = np - p_offset;
+            }
 
-            m_giv[thread_num].resize(np);
+            if (!fused && region != EvolveRegion::Boundary)
+            {
+                Exp.assign(np,0.0);
+                Eyp.assign(np,0.0);
+                Ezp.assign(np,0.0);
+                Bxp.assign(np,WarpX::B_external[0]);
+                Byp.assign(np,WarpX::B_external[1]);
+                Bzp.assign(np,WarpX::B_external[2]);
+
+                m_giv[thread_num].resize(np);
+            }
+            else if (!fused)
+            {
+                // Only reset the fields of the boundary particles: those of the
+                // interior particles may be stored as particle attributes
+                Exp.resize(np);
+                Eyp.resize(np);
+                Ezp.resize(np);
+                Bxp.resize(np);
+                Byp.resize(np);
+                Bzp.resize(np);
+                Real* const AMREX_RESTRICT ex = Exp.dataPtr();
+                Real* const AMREX_RESTRICT ey = Eyp.dataPtr();
+                Real* const AMREX_RESTRICT ez = Ezp.dataPtr();
+                Real* const AMREX_RESTRICT bx = Bxp.dataPtr();
+                Real* const AMREX_RESTRICT by = Byp.dataPtr();
+                Real* const AMREX_RESTRICT bz = Bzp.dataPtr();
+                const Real bx_ext = WarpX::B_external[0];
+                const Real by_ext = WarpX::B_external[1];
+                const Real bz_ext = WarpX::B_external[2];
+                amrex::ParallelFor( p_count,
+                    [=] AMREX_GPU_DEVICE (long ip) {
+                        const long i = ip + p_offset;
+                        ex[i] = 0.0;
+                        ey[i] = 0.0;
+                        ez[i] = 0.0;
+                        bx[i] = bx_ext;
+                        by[i] = by_ext;
+                        bz[i] = bz_ext;
+                    }
+                );
+
+                m_giv[thread_num].resize(np);
+            }
 
             long nfine_current = np;
             long nfine_gather = np;
@@ -1147,25 +1335,34 @@ PhysicalParticleContainer::Evolve (int lev,
                 BL_PROFILE_VAR_STOP(blp_partition);
             }
 
-            const long np_current = (cjx) ? nfine_current : np;
+            const long np_current = (cjx) ? nfine_current : p_count;
             
-            //
-            // copy data from particle container to temp arrays
-            //
-            BL_PROFILE_VAR_START(blp_copy);
-            pti.GetPosition(m_xp[thread_num], m_yp[thread_num], m_zp[thread_num]);
-            BL_PROFILE_VAR_STOP(blp_copy);
-
-            if (rho) {
-                DepositCharge(pti, wp, rho, 0, 0, np_current, thread_num, lev, lev);
+            // The charge before the push is deposited for all the particles
+            // in the first pass (it does not depend on the fields)
+            if (rho && region != EvolveRegion::Boundary) {
+                DepositCharge(pti, wp, rho, 0, 0, (cjx) ? nfine_current : np,
+                              thread_num, lev, lev);
                 if (has_buffer){
                     DepositCharge(pti, wp, crho, 0, np_current, np-np_current, thread_num, lev, lev-1);
                 }
             }
             
-            if (! do_not_push)
+            if (fused)
             {
-                const long np_gather = (cEx) ? nfine_gather : np;
+                int e_is_nodal = Ex.is_nodal() and Ey.is_nodal() and Ez.is_nodal();
+
+                //
+                // Field gather, particle push and current deposition
+                //
+                BL_PROFILE_VAR_START(blp_fused);
+                GatherPushDeposit(pti, exfab, eyfab, ezfab, bxfab, byfab, bzfab,
+                                  Ex.nGrow(), e_is_nodal, &jx, &jy, &jz,
+                                  thread_num, lev, dt);
+                BL_PROFILE_VAR_STOP(blp_fused);
+            }
+            else if (! do_not_push)
+            {
+                const long np_gather = (cEx) ? nfine_gather : p_count;
 
                 int e_is_nodal = Ex.is_nodal() and Ey.is_nodal() and Ez.is_nodal();
 
@@ -1175,9 +1372,9 @@ PhysicalParticleContainer::Evolve (int lev,
                 BL_PROFILE_VAR_START(blp_pxr_fg);
                 FieldGather(pti, Exp, Eyp, Ezp, Bxp, Byp, Bzp,
                             exfab, eyfab, ezfab, bxfab, byfab, bzfab, 
-                            Ex.nGrow(), e_is_nodal, 0, np_gather, thread_num, lev, lev);
+                            Ex.nGrow(), e_is_nodal, p_offset, np_gather, thread_num, lev, lev);
 
-                if (np_gather < np)
+                if (cEx && np_gather < np)
                 {
                     const IntVect& ref_ratio = WarpX::RefRatio(lev-1);
                     const Box& cbox = amrex::coarsen(box,ref_ratio);
@@ -1258,17 +1455,22 @@ PhysicalParticleContainer::Evolve (int lev,
                 // Particle Push
                 //
                 BL_PROFILE_VAR_START(blp_ppc_pp);
-                PushPX(pti, m_xp[thread_num], m_yp[thread_num], m_zp[thread_num], 
-                       m_giv[thread_num], dt);
+                PushPX(pti, m_giv[thread_num], Exp, Eyp, Ezp, Bxp, Byp, Bzp, dt,
+                       p_offset, p_count);
                 BL_PROFILE_VAR_STOP(blp_ppc_pp);
 
                 //
                 // Current Deposition
                 //
                 if (WarpX::use_picsar_deposition) {
+                    // The Fortran deposition needs the pushed
+                    // positions in temporary arrays
+                    BL_PROFILE_VAR_START(blp_copy);
+                    pti.GetPosition(m_xp[thread_num], m_yp[thread_num], m_zp[thread_num]);
+                    BL_PROFILE_VAR_STOP(blp_copy);
                     // Deposit inside domains
                     DepositCurrentFortran(pti, wp, uxp, uyp, uzp, &jx, &jy, &jz,
-                                          0, np_current, thread_num,
+                                          p_offset, np_current, thread_num,
                                           lev, lev, dt);
                     if (has_buffer){
                         // Deposit in buffers
@@ -1279,7 +1481,7 @@ PhysicalParticleContainer::Evolve (int lev,
                 } else {
                     // Deposit inside domains
                     DepositCurrent(pti, wp, uxp, uyp, uzp, &jx, &jy, &jz,
-                                   0, np_current, thread_num,
+                                   p_offset, np_current, thread_num,
                                    lev, lev, dt);
                     if (has_buffer){
                         // Deposit in buffers
@@ -1288,17 +1490,10 @@ PhysicalParticleContainer::Evolve (int lev,
                                        lev, lev-1, dt);
                     }
                 }
-
-                //
-                // copy particle data back
-                //
-                BL_PROFILE_VAR_START(blp_copy);
-                pti.SetPosition(m_xp[thread_num], m_yp[thread_num], m_zp[thread_num]);
-                BL_PROFILE_VAR_STOP(blp_copy);
             }
             
             if (rho) {
-                DepositCharge(pti, wp, rho, 1, 0, np_current, thread_num, lev, lev);
+                DepositCharge(pti, wp, rho, 1, p_offset, np_current, thread_num, lev, lev);
                 if (has_buffer){
                     DepositCharge(pti, wp, crho, 1, np_current, np-np_current, thread_num, lev, lev-1);
                 }
@@ -1317,7 +1512,69 @@ PhysicalParticleContainer::Evolve (int lev,
         }
     }
     // Split particles
-    if (do_splitting){ SplitParticles(lev); }
+    if (do_splitting && region != EvolveRegion::Interior){ SplitParticles(lev); }
+}
+
+/* \brief Reorder the particles of the tile so that those whose field gather
+ * stencil lies within the valid box come first (stable partition), and
+ * return their number. These particles do not use the guard cells of E and B.
+ * All the real and integer attributes, including the runtime ones, are
+ * reordered. */
+long
+PhysicalParticleContainer::PartitionInteriorParticles (WarpXParIter& pti, int lev,
+                                                       Vector<long>& pid,
+                                                       ParticleVector& particle_tmp,
+                                                       RealVector& tmp,
+                                                       IntVector& int_tmp)
+{
+    const long np = pti.numParticles();
+    const Box interior_box = InteriorGatherBox(pti);
+    auto& aos = pti.GetArrayOfStructs();
+
+    // Nothing to reorder if the tile is already partitioned (e.g. all the
+    // particles are on the same side, or SortParticlesByBin put the
+    // interior particles first)
+    long n_interior = 0;
+    bool partitioned = true;
+    for (long ip = 0; ip < np; ++ip) {
+        if (interior_box.contains(Index(aos[ip], lev))) {
+            if (n_interior != ip) partitioned = false;
+            ++n_interior;
+        }
+    }
+    if (partitioned) return n_interior;
+
+    pid.resize(np);
+    std::iota(pid.begin(), pid.end(), 0L);
+    std::stable_partition(pid.begin(), pid.end(),
+        [&](long id) { return interior_box.contains(Index(aos[id], lev)); });
+
+    particle_tmp.resize(np);
+    for (long ip = 0; ip < np; ++ip) {
+        particle_tmp[ip] = aos[pid[ip]];
+    }
+    std::swap(aos(), particle_tmp);
+
+    tmp.resize(np);
+    for (int comp = 0; comp < NumRealComps(); ++comp) {
+        auto& attrib = pti.GetAttribs(comp);
+        for (long ip = 0; ip < np; ++ip) {
+            tmp[ip] = attrib[pid[ip]];
+        }
+        std::swap(attrib, tmp);
+    }
+
+    auto& soa = pti.GetStructOfArrays();
+    int_tmp.resize(np);
+    for (int comp = 0; comp < NumIntComps(); ++comp) {
+        auto& attrib = soa.GetIntData(comp);
+        for (long ip = 0; ip < np; ++ip) {
+            int_tmp[ip] = attrib[pid[ip]];
+        }
+        std::swap(attrib, int_tmp);
+    }
+
+    return n_interior;
 }
 
 // Loop over all particles in the particle container and
@@ -1455,7 +1712,7 @@ PhysicalParticleContainer::SplitParticles(int lev)
 	// particle container pctmp_split. Split particles
 	// are tagged with p.id()=NoSplitParticleID so that 
 	// they are not re-split when entering a higher level
-	// AddNParticles calls Redistribute, so that particles
+	// AddNParticles calls RedistributeNew, so that particles
 	// in pctmp_split are in the proper grids and tiles
 	pctmp_split.AddNParticles(lev, 
                               np_split_to_add,
@@ -1476,54 +1733,61 @@ PhysicalParticleContainer::SplitParticles(int lev)
 
 void
 PhysicalParticleContainer::PushPX(WarpXParIter& pti,
-                                  Cuda::ManagedDeviceVector<Real>& xp,
-                                  Cuda::ManagedDeviceVector<Real>& yp,
-                                  Cuda::ManagedDeviceVector<Real>& zp,
                                   Cuda::ManagedDeviceVector<Real>& giv,
-                                  Real dt)
+                                  RealVector& Exp, RealVector& Eyp, RealVector& Ezp,
+                                  RealVector& Bxp, RealVector& Byp, RealVector& Bzp,
+                                  Real dt, long offset, long np_to_push)
 {
 
     // This wraps the momentum and position advance so that inheritors can modify the call.
     auto& attribs = pti.GetAttribs();
-    // Extract pointers to the different particle quantities
-    Real* const AMREX_RESTRICT x = xp.dataPtr();
-    Real* const AMREX_RESTRICT y = yp.dataPtr();
-    Real* const AMREX_RESTRICT z = zp.dataPtr();
+    // Extract pointers to the different particle quantities.
+    // The positions are read and written in place in the particle structs.
+    const GetParticlePosition getPosition(pti);
+    const SetParticlePosition setPosition(pti);
     Real* const AMREX_RESTRICT gi = giv.dataPtr();
     Real* const AMREX_RESTRICT ux = attribs[PIdx::ux].dataPtr();
     Real* const AMREX_RESTRICT uy = attribs[PIdx::uy].dataPtr();
     Real* const AMREX_RESTRICT uz = attribs[PIdx::uz].dataPtr();
-    const Real* const AMREX_RESTRICT Ex = attribs[PIdx::Ex].dataPtr();
-    const Real* const AMREX_RESTRICT Ey = attribs[PIdx::Ey].dataPtr();
-    const Real* const AMREX_RESTRICT Ez = attribs[PIdx::Ez].dataPtr();
-    const Real* const AMREX_RESTRICT Bx = attribs[PIdx::Bx].dataPtr();
-    const Real* const AMREX_RESTRICT By = attribs[PIdx::By].dataPtr();
-    const Real* const AMREX_RESTRICT Bz = attribs[PIdx::Bz].dataPtr();
+    const Real* const AMREX_RESTRICT Ex = Exp.dataPtr();
+    const Real* const AMREX_RESTRICT Ey = Eyp.dataPtr();
+    const Real* const AMREX_RESTRICT Ez = Ezp.dataPtr();
+    const Real* const AMREX_RESTRICT Bx = Bxp.dataPtr();
+    const Real* const AMREX_RESTRICT By = Byp.dataPtr();
+    const Real* const AMREX_RESTRICT Bz = Bzp.dataPtr();
 
     if (WarpX::do_boosted_frame_diagnostic && do_boosted_frame_diags)
     {
-        copy_attribs(pti, x, y, z);
+        copy_attribs(pti, offset, np_to_push);
     }
 
     // Loop over the particles and update their momentum
     const Real q = this->charge;
     const Real m = this-> mass;
     if (WarpX::particle_pusher_algo == ParticlePusherAlgo::Boris){
-        amrex::ParallelFor( pti.numParticles(),
-            [=] AMREX_GPU_DEVICE (long i) {
+        amrex::ParallelFor( np_to_push,
+            [=] AMREX_GPU_DEVICE (long ip) {
+                const long i = ip + offset;
+                Real x, y, z;
+                getPosition(i, x, y, z);
                 UpdateMomentumBoris( ux[i], uy[i], uz[i], gi[i],
                       Ex[i], Ey[i], Ez[i], Bx[i], By[i], Bz[i], q, m, dt);
-                UpdatePosition( x[i], y[i], z[i],
+                UpdatePosition( x, y, z,
                       ux[i], uy[i], uz[i], dt );
+                setPosition(i, x, y, z);
             }
         );
     } else if (WarpX::particle_pusher_algo == ParticlePusherAlgo::Vay) {
-        amrex::ParallelFor( pti.numParticles(),
-            [=] AMREX_GPU_DEVICE (long i) {
+        amrex::ParallelFor( np_to_push,
+            [=] AMREX_GPU_DEVICE (long ip) {
+                const long i = ip + offset;
+                Real x, y, z;
+                getPosition(i, x, y, z);
                 UpdateMomentumVay( ux[i], uy[i], uz[i], gi[i],
                       Ex[i], Ey[i], Ez[i], Bx[i], By[i], Bz[i], q, m, dt);
-                UpdatePosition( x[i], y[i], z[i],
+                UpdatePosition( x, y, z,
                       ux[i], uy[i], uz[i], dt );
+                setPosition(i, x, y, z);
             }
         );
     } else {
@@ -1557,12 +1821,14 @@ PhysicalParticleContainer::PushP (int lev, Real dt,
 
             auto& attribs = pti.GetAttribs();
 
-            auto& Exp = attribs[PIdx::Ex];
-            auto& Eyp = attribs[PIdx::Ey];
-            auto& Ezp = attribs[PIdx::Ez];
-            auto& Bxp = attribs[PIdx::Bx];
-            auto& Byp = attribs[PIdx::By];
-            auto& Bzp = attribs[PIdx::Bz];
+            // Fields on particles: attributes if saved, scratch otherwise
+            auto fields = GetFieldsOnParticles(pti, thread_num);
+            auto& Exp = *fields[0];
+            auto& Eyp = *fields[1];
+            auto& Ezp = *fields[2];
+            auto& Bxp = *fields[3];
+            auto& Byp = *fields[4];
+            auto& Bzp = *fields[5];
 
             const long np = pti.numParticles();
 
@@ -1583,11 +1849,6 @@ PhysicalParticleContainer::PushP (int lev, Real dt,
 
             m_giv[thread_num].resize(np);
 
-            //
-            // copy data from particle container to temp arrays
-            //
-            pti.GetPosition(m_xp[thread_num], m_yp[thread_num], m_zp[thread_num]);
-
             int e_is_nodal = Ex.is_nodal() and Ey.is_nodal() and Ez.is_nodal();
             FieldGather(pti, Exp, Eyp, Ezp, Bxp, Byp, Bzp,
                         &exfab, &eyfab, &ezfab, &bxfab, &byfab, &bzfab, 
@@ -1630,9 +1891,10 @@ PhysicalParticleContainer::PushP (int lev, Real dt,
     }
 }
 
-void PhysicalParticleContainer::copy_attribs(WarpXParIter& pti,const Real* xp,
-                                             const Real* yp, const Real* zp)
+void PhysicalParticleContainer::copy_attribs(WarpXParIter& pti,
+                                             long offset, long np_to_copy)
 {
+    const GetParticlePosition getPosition(pti);
 
     auto& attribs = pti.GetAttribs();
     
@@ -1647,13 +1909,10 @@ void PhysicalParticleContainer::copy_attribs(WarpXParIter& pti,const Real* xp,
     Real* AMREX_RESTRICT uypold = pti.GetAttribs(particle_comps["uyold"]).dataPtr();
     Real* AMREX_RESTRICT uzpold = pti.GetAttribs(particle_comps["uzold"]).dataPtr();
     
-    const long np = pti.numParticles();
-    
-    ParallelFor( np,
-                 [=] AMREX_GPU_DEVICE (long i) {
-                     xpold[i]=xp[i];
-                     ypold[i]=yp[i];
-                     zpold[i]=zp[i];
+    ParallelFor( np_to_copy,
+                 [=] AMREX_GPU_DEVICE (long ip) {
+                     const long i = ip + offset;
+                     getPosition(i, xpold[i], ypold[i], zpold[i]);
             
                      uxpold[i]=uxp[i];
                      uypold[i]=uyp[i];
@@ -1665,7 +1924,7 @@ void PhysicalParticleContainer::copy_attribs(WarpXParIter& pti,const Real* xp,
 void PhysicalParticleContainer::GetParticleSlice(const int direction, const Real z_old,
                                                  const Real z_new, const Real t_boost,
                                                  const Real t_lab, const Real dt,
-                                                 DiagnosticParticles& diagnostic_particles)
+                                                 DiagnosticParticleData& diagnostic_particles)
 {
     BL_PROFILE("PhysicalParticleContainer::GetParticleSlice");
 
@@ -1693,98 +1952,146 @@ void PhysicalParticleContainer::GetParticleSlice(const int direction, const Real
     slice_box.setLo(direction, z_min);
     slice_box.setHi(direction, z_max);
 
-    diagnostic_particles.resize(finestLevel()+1);
-    
+    const Real uzfrm = -WarpX::gamma_boost*WarpX::beta_boost*PhysConst::c;
+    const Real inv_c2 = 1.0/PhysConst::c/PhysConst::c;
+
+    const int  ixold = particle_comps["xold"];
+    const int  iyold = particle_comps["yold"];
+    const int  izold = particle_comps["zold"];
+    const int iuxold = particle_comps["uxold"];
+    const int iuyold = particle_comps["uyold"];
+    const int iuzold = particle_comps["uzold"];
+
     for (int lev = 0; lev < nlevs; ++lev) {
 
         const Real* dx  = Geom(lev).CellSize();
         const Real* plo = Geom(lev).ProbLo();
 
-        // first we touch each map entry in serial
+        // The crossing particles are gathered in two passes: each tile
+        // first counts its particles that crossed the plane, then, after a
+        // prefix sum over the tiles, writes them directly at their final
+        // place in diagnostic_particles. The tiles are identified by
+        // [local grid index][tile index].
+        Vector<Vector<long> > tile_count;
         for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
         {
-            auto index = std::make_pair(pti.index(), pti.LocalTileIndex());
-            diagnostic_particles[lev][index];
+            const int li = pti.LocalIndex();
+            if (li >= static_cast<int>(tile_count.size())) tile_count.resize(li+1);
+            if (pti.LocalTileIndex() >= static_cast<int>(tile_count[li].size())) {
+                tile_count[li].resize(pti.LocalTileIndex()+1, 0);
+            }
         }
 
+        // First pass: count
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
+        for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
         {
-            RealVector xp_new, yp_new, zp_new;
-
-            for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
-            {
-                const Box& box = pti.validbox();
+            const RealBox tile_real_box(pti.validbox(), dx, plo);
+            if ( !slice_box.intersects(tile_real_box) ) continue;
 
-                auto index = std::make_pair(pti.index(), pti.LocalTileIndex());
+            const GetParticlePosition getPosition(pti);
+            const Real* const AMREX_RESTRICT zp_old = pti.GetAttribs(izold).dataPtr();
+            const long np = pti.numParticles();
 
-                const RealBox tile_real_box(box, dx, plo);
+            long count = 0;
+            for (long i = 0; i < np; ++i) {
+                Real xp_new, yp_new, zp_new;
+                getPosition(i, xp_new, yp_new, zp_new);
+                // the particle crossed the plane of z_boost in the last timestep
+                count += ( ((zp_new >= z_new) && (zp_old[i] <= z_old)) ||
+                           ((zp_new <= z_new) && (zp_old[i] >= z_old)) );
+            }
+            tile_count[pti.LocalIndex()][pti.LocalTileIndex()] = count;
+        }
 
-                if ( !slice_box.intersects(tile_real_box) ) continue;
+        // Exclusive prefix sum, starting after the particles already stored
+        long total = diagnostic_particles.GetRealData(DiagIdx::w).size();
+        for (auto& counts : tile_count) {
+            for (auto& c : counts) {
+                const long n = c;
+                c = total;
+                total += n;
+            }
+        }
+        for (int comp = 0; comp < DiagIdx::nattribs; ++comp) {
+            diagnostic_particles.GetRealData(comp).resize(total);
+        }
+        Real* const AMREX_RESTRICT wp_diag  = diagnostic_particles.GetRealData(DiagIdx::w ).dataPtr();
+        Real* const AMREX_RESTRICT xp_diag  = diagnostic_particles.GetRealData(DiagIdx::x ).dataPtr();
+        Real* const AMREX_RESTRICT yp_diag  = diagnostic_particles.GetRealData(DiagIdx::y ).dataPtr();
+        Real* const AMREX_RESTRICT zp_diag  = diagnostic_particles.GetRealData(DiagIdx::z ).dataPtr();
+        Real* const AMREX_RESTRICT uxp_diag = diagnostic_particles.GetRealData(DiagIdx::ux).dataPtr();
+        Real* const AMREX_RESTRICT uyp_diag = diagnostic_particles.GetRealData(DiagIdx::uy).dataPtr();
+        Real* const AMREX_RESTRICT uzp_diag = diagnostic_particles.GetRealData(DiagIdx::uz).dataPtr();
+
+        // Second pass: Lorentz transform the crossing particles and write
+        // them at their offset
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
+        {
+            const RealBox tile_real_box(pti.validbox(), dx, plo);
+            if ( !slice_box.intersects(tile_real_box) ) continue;
 
-                pti.GetPosition(xp_new, yp_new, zp_new);
+            const GetParticlePosition getPosition(pti);
 
-                auto& attribs = pti.GetAttribs();
+            auto& attribs = pti.GetAttribs();
 
-                auto& wp = attribs[PIdx::w ];
+            const Real* const AMREX_RESTRICT wp = attribs[PIdx::w].dataPtr();
 
-                auto& uxp_new = attribs[PIdx::ux   ];
-                auto& uyp_new = attribs[PIdx::uy   ];
-                auto& uzp_new = attribs[PIdx::uz   ];
+            const Real* const AMREX_RESTRICT uxp_new = attribs[PIdx::ux].dataPtr();
+            const Real* const AMREX_RESTRICT uyp_new = attribs[PIdx::uy].dataPtr();
+            const Real* const AMREX_RESTRICT uzp_new = attribs[PIdx::uz].dataPtr();
 
-                auto&  xp_old = pti.GetAttribs(particle_comps["xold"]);
-                auto&  yp_old = pti.GetAttribs(particle_comps["yold"]);
-                auto&  zp_old = pti.GetAttribs(particle_comps["zold"]);
-                auto& uxp_old = pti.GetAttribs(particle_comps["uxold"]);
-                auto& uyp_old = pti.GetAttribs(particle_comps["uyold"]);
-                auto& uzp_old = pti.GetAttribs(particle_comps["uzold"]);
+            const Real* const AMREX_RESTRICT  xp_old = pti.GetAttribs(ixold).dataPtr();
+            const Real* const AMREX_RESTRICT  yp_old = pti.GetAttribs(iyold).dataPtr();
+            const Real* const AMREX_RESTRICT  zp_old = pti.GetAttribs(izold).dataPtr();
+            const Real* const AMREX_RESTRICT uxp_old = pti.GetAttribs(iuxold).dataPtr();
+            const Real* const AMREX_RESTRICT uyp_old = pti.GetAttribs(iuyold).dataPtr();
+            const Real* const AMREX_RESTRICT uzp_old = pti.GetAttribs(iuzold).dataPtr();
 
-                const long np = pti.numParticles();
+            const long np = pti.numParticles();
+            long ip = tile_count[pti.LocalIndex()][pti.LocalTileIndex()];
 
-                Real uzfrm = -WarpX::gamma_boost*WarpX::beta_boost*PhysConst::c;
-                Real inv_c2 = 1.0/PhysConst::c/PhysConst::c;
+            for (long i = 0; i < np; ++i) {
 
-                for (long i = 0; i < np; ++i) {
+                Real xp_new, yp_new, zp_new;
+                getPosition(i, xp_new, yp_new, zp_new);
 
-                    // if the particle did not cross the plane of z_boost in the last
-                    // timestep, skip it.
-                    if ( not (((zp_new[i] >= z_new) && (zp_old[i] <= z_old)) ||
-                              ((zp_new[i] <= z_new) && (zp_old[i] >= z_old))) ) continue;
+                // if the particle did not cross the plane of z_boost in the last
+                // timestep, skip it.
+                if ( not (((zp_new >= z_new) && (zp_old[i] <= z_old)) ||
+                          ((zp_new <= z_new) && (zp_old[i] >= z_old))) ) continue;
 
-                    // Lorentz transform particles to lab frame
-                    Real gamma_new_p = std::sqrt(1.0 + inv_c2*(uxp_new[i]*uxp_new[i] + uyp_new[i]*uyp_new[i] + uzp_new[i]*uzp_new[i]));
-                    Real t_new_p = WarpX::gamma_boost*t_boost - uzfrm*zp_new[i]*inv_c2;
-                    Real z_new_p = WarpX::gamma_boost*(zp_new[i] + WarpX::beta_boost*PhysConst::c*t_boost);
-                    Real uz_new_p = WarpX::gamma_boost*uzp_new[i] - gamma_new_p*uzfrm;
+                // Lorentz transform particles to lab frame
+                Real gamma_new_p = std::sqrt(1.0 + inv_c2*(uxp_new[i]*uxp_new[i] + uyp_new[i]*uyp_new[i] + uzp_new[i]*uzp_new[i]));
+                Real t_new_p = WarpX::gamma_boost*t_boost - uzfrm*zp_new*inv_c2;
+                Real z_new_p = WarpX::gamma_boost*(zp_new + WarpX::beta_boost*PhysConst::c*t_boost);
+                Real uz_new_p = WarpX::gamma_boost*uzp_new[i] - gamma_new_p*uzfrm;
 
-                    Real gamma_old_p = std::sqrt(1.0 + inv_c2*(uxp_old[i]*uxp_old[i] + uyp_old[i]*uyp_old[i] + uzp_old[i]*uzp_old[i]));
-                    Real t_old_p = WarpX::gamma_boost*(t_boost - dt) - uzfrm*zp_old[i]*inv_c2;
-                    Real z_old_p = WarpX::gamma_boost*(zp_old[i] + WarpX::beta_boost*PhysConst::c*(t_boost-dt));
-                    Real uz_old_p = WarpX::gamma_boost*uzp_old[i] - gamma_old_p*uzfrm;
+                Real gamma_old_p = std::sqrt(1.0 + inv_c2*(uxp_old[i]*uxp_old[i] + uyp_old[i]*uyp_old[i] + uzp_old[i]*uzp_old[i]));
+                Real t_old_p = WarpX::gamma_boost*(t_boost - dt) - uzfrm*zp_old[i]*inv_c2;
+                Real z_old_p = WarpX::gamma_boost*(zp_old[i] + WarpX::beta_boost*PhysConst::c*(t_boost-dt));
+                Real uz_old_p = WarpX::gamma_boost*uzp_old[i] - gamma_old_p*uzfrm;
 
-                    // interpolate in time to t_lab
-                    Real weight_old = (t_new_p - t_lab) / (t_new_p - t_old_p);
-                    Real weight_new = (t_lab - t_old_p) / (t_new_p - t_old_p);
+                // interpolate in time to t_lab
+                Real weight_old = (t_new_p - t_lab) / (t_new_p - t_old_p);
+                Real weight_new = (t_lab - t_old_p) / (t_new_p - t_old_p);
 
-                    Real xp = xp_old[i]*weight_old + xp_new[i]*weight_new;
-                    Real yp = yp_old[i]*weight_old + yp_new[i]*weight_new;
-                    Real zp = z_old_p  *weight_old + z_new_p  *weight_new;
+                wp_diag[ip] = wp[i];
 
-                    Real uxp = uxp_old[i]*weight_old + uxp_new[i]*weight_new;
-                    Real uyp = uyp_old[i]*weight_old + uyp_new[i]*weight_new;
-                    Real uzp = uz_old_p  *weight_old + uz_new_p  *weight_new;
+                xp_diag[ip] = xp_old[i]*weight_old + xp_new*weight_new;
+                yp_diag[ip] = yp_old[i]*weight_old + yp_new*weight_new;
+                zp_diag[ip] = z_old_p  *weight_old + z_new_p  *weight_new;
 
-                    diagnostic_particles[lev][index].GetRealData(DiagIdx::w).push_back(wp[i]);
-                    
-                    diagnostic_particles[lev][index].GetRealData(DiagIdx::x).push_back(xp);
-                    diagnostic_particles[lev][index].GetRealData(DiagIdx::y).push_back(yp);
-                    diagnostic_particles[lev][index].GetRealData(DiagIdx::z).push_back(zp);
+                uxp_diag[ip] = uxp_old[i]*weight_old + uxp_new[i]*weight_new;
+                uyp_diag[ip] = uyp_old[i]*weight_old + uyp_new[i]*weight_new;
+                uzp_diag[ip] = uz_old_p  *weight_old + uz_new_p  *weight_new;
 
-                    diagnostic_particles[lev][index].GetRealData(DiagIdx::ux).push_back(uxp);
-                    diagnostic_particles[lev][index].GetRealData(DiagIdx::uy).push_back(uyp);
-                    diagnostic_particles[lev][index].GetRealData(DiagIdx::uz).push_back(uzp);
-                }
+                ++ip;
             }
         }
     }
@@ -1866,20 +2173,43 @@ PhysicalParticleContainer::FieldGather (WarpXParIter& pti,
     const Array4<const Real>& by_arr = byfab->array();
     const Array4<const Real>& bz_arr = bzfab->array();
     
-    const Real * const AMREX_RESTRICT xp = m_xp[thread_num].dataPtr() + offset;
-    const Real * const AMREX_RESTRICT zp = m_zp[thread_num].dataPtr() + offset;
-    const Real * const AMREX_RESTRICT yp = m_yp[thread_num].dataPtr() + offset;
+    // Positions are read in place from the particle structs
+    const GetParticlePosition getPosition(pti, offset);
     
     // Lower corner of tile box physical domain
     const std::array<Real, 3>& xyzmin = WarpX::LowerCorner(box, gather_lev);
     
     const Dim3 lo = lbound(box);
-    
+
+#if (defined WARPX_USE_EXPLICIT_SIMD) && (!defined AMREX_USE_GPU) && (!defined WARPX_DIM_RZ)
+    // Gather in SIMD batches of particles, directly from the field tiles
+    {
+#define WARPX_GATHER_SIMD(N, LOWER)                                         \
+        doGatherShapeNSimd<N,LOWER>(getPosition,                            \
+            Exp.dataPtr() + offset, Eyp.dataPtr() + offset,                 \
+            Ezp.dataPtr() + offset, Bxp.dataPtr() + offset,                 \
+            Byp.dataPtr() + offset, Bzp.dataPtr() + offset,                 \
+            ex_arr, ey_arr, ez_arr, bx_arr, by_arr, bz_arr,                 \
+            np_to_gather, dx, xyzmin, lo, stagger_shift)
+        if (WarpX::l_lower_order_in_v){
+            if      (WarpX::nox == 1) WARPX_GATHER_SIMD(1,1);
+            else if (WarpX::nox == 2) WARPX_GATHER_SIMD(2,1);
+            else if (WarpX::nox == 3) WARPX_GATHER_SIMD(3,1);
+        } else {
+            if      (WarpX::nox == 1) WARPX_GATHER_SIMD(1,0);
+            else if (WarpX::nox == 2) WARPX_GATHER_SIMD(2,0);
+            else if (WarpX::nox == 3) WARPX_GATHER_SIMD(3,0);
+        }
+#undef WARPX_GATHER_SIMD
+        return;
+    }
+#endif
+
     // Depending on l_lower_in_v and WarpX::nox, call
     // different versions of template function doGatherShapeN
     if (WarpX::l_lower_order_in_v){
         if        (WarpX::nox == 1){
-            doGatherShapeN<1,1>(xp, yp, zp,
+            doGatherShapeN<1,1>(getPosition,
                                 Exp.dataPtr() + offset, Eyp.dataPtr() + offset,
                                 Ezp.dataPtr() + offset, Bxp.dataPtr() + offset,
                                 Byp.dataPtr() + offset, Bzp.dataPtr() + offset,
@@ -1887,7 +2217,7 @@ PhysicalParticleContainer::FieldGather (WarpXParIter& pti,
                                 np_to_gather, dx,
                                 xyzmin, lo, stagger_shift);
         } else if (WarpX::nox == 2){
-            doGatherShapeN<2,1>(xp, yp, zp,
+            doGatherShapeN<2,1>(getPosition,
                                 Exp.dataPtr() + offset, Eyp.dataPtr() + offset,
                                 Ezp.dataPtr() + offset, Bxp.dataPtr() + offset,
                                 Byp.dataPtr() + offset, Bzp.dataPtr() + offset,
@@ -1895,7 +2225,7 @@ PhysicalParticleContainer::FieldGather (WarpXParIter& pti,
                                 np_to_gather, dx,
                                 xyzmin, lo, stagger_shift);
         } else if (WarpX::nox == 3){
-            doGatherShapeN<3,1>(xp, yp, zp,
+            doGatherShapeN<3,1>(getPosition,
                                 Exp.dataPtr() + offset, Eyp.dataPtr() + offset,
                                 Ezp.dataPtr() + offset, Bxp.dataPtr() + offset,
                                 Byp.dataPtr() + offset, Bzp.dataPtr() + offset,
@@ -1905,7 +2235,7 @@ PhysicalParticleContainer::FieldGather (WarpXParIter& pti,
         }
     } else {
         if        (WarpX::nox == 1){
-            doGatherShapeN<1,0>(xp, yp, zp,
+            doGatherShapeN<1,0>(getPosition,
                                 Exp.dataPtr() + offset, Eyp.dataPtr() + offset,
                                 Ezp.dataPtr() + offset, Bxp.dataPtr() + offset,
                                 Byp.dataPtr() + offset, Bzp.dataPtr() + offset,
@@ -1913,7 +2243,7 @@ PhysicalParticleContainer::FieldGather (WarpXParIter& pti,
                                 np_to_gather, dx,
                                 xyzmin, lo, stagger_shift);
         } else if (WarpX::nox == 2){
-            doGatherShapeN<2,0>(xp, yp, zp,
+            doGatherShapeN<2,0>(getPosition,
                                 Exp.dataPtr() + offset, Eyp.dataPtr() + offset,
                                 Ezp.dataPtr() + offset, Bxp.dataPtr() + offset,
                                 Byp.dataPtr() + offset, Bzp.dataPtr() + offset,
@@ -1921,7 +2251,7 @@ PhysicalParticleContainer::FieldGather (WarpXParIter& pti,
                                 np_to_gather, dx,
                                 xyzmin, lo, stagger_shift);
         } else if (WarpX::nox == 3){
-            doGatherShapeN<3,0>(xp, yp, zp,
+            doGatherShapeN<3,0>(getPosition,
                                 Exp.dataPtr() + offset, Eyp.dataPtr() + offset,
                                 Ezp.dataPtr() + offset, Bxp.dataPtr() + offset,
                                 Byp.dataPtr() + offset, Bzp.dataPtr() + offset,
@@ -1931,3 +2261,152 @@ PhysicalParticleContainer::FieldGather (WarpXParIter& pti,
         }
     }
 }
+
+/* \brief Fused field gather, particle push and current deposition for all
+ * the particles of pti, in a single pass over the particles.
+ * The fields on the particles are only written to the particle attributes
+ * when save_fields_on_particles is set; otherwise they stay in registers.
+ * Gather and deposition buffers are not supported.
+ * \param pti: Particle iterator
+ * \param exfab eyfab ezfab bxfab byfab bzfab: fields on the grid
+ * \param ngE: number of guard cells for E
+ * \param e_is_nodal: 0 if E is staggered, 1 if E is nodal
+ * \param jx jy jz: full arrays of current density
+ * \param thread_num: if using OpenMP, thread number
+ * \param lev: level on which particles are located
+ * \param dt: time step for particle level
+ */
+void
+PhysicalParticleContainer::GatherPushDeposit (WarpXParIter& pti,
+                                              FArrayBox const * exfab,
+                                              FArrayBox const * eyfab,
+                                              FArrayBox const * ezfab,
+                                              FArrayBox const * bxfab,
+                                              FArrayBox const * byfab,
+                                              FArrayBox const * bzfab,
+                                              const int ngE, const int e_is_nodal,
+                                              MultiFab* jx, MultiFab* jy, MultiFab* jz,
+                                              int thread_num, int lev, Real dt)
+{
+    const long np = pti.numParticles();
+    // If no particles, do not do anything
+    if (np == 0) return;
+
+    BL_PROFILE_VAR_NS("PPC::Evolve::Accumulate", blp_accumulate);
+
+    const std::array<Real,3>& dx = WarpX::CellSize(lev);
+
+    // Box from which the fields are gathered, including guard cells
+    Box gather_box = pti.tilebox();
+    gather_box.grow(ngE);
+    const std::array<Real,3>& xyzmin_gather = WarpX::LowerCorner(gather_box, lev);
+    const Dim3 lo_gather = lbound(gather_box);
+    const Real gather_stagger_shift = e_is_nodal ? 0.0 : 0.5;
+
+    // Box into which the current is deposited, and
+    // staggered tile boxes (different in each direction)
+    const long ngJ = jx->nGrow();
+    const int j_is_nodal = jx->is_nodal() and jy->is_nodal() and jz->is_nodal();
+    const Real depos_stagger_shift = j_is_nodal ? 0.0 : 0.5;
+    Box tilebox = pti.tilebox();
+    Box tbx = convert(tilebox, WarpX::jx_nodal_flag);
+    Box tby = convert(tilebox, WarpX::jy_nodal_flag);
+    Box tbz = convert(tilebox, WarpX::jz_nodal_flag);
+    tilebox.grow(ngJ);
+
+#ifdef AMREX_USE_GPU
+    // No tiling on GPU: deposit directly in jx (same for jy and jz)
+    Array4<Real> const& jx_arr = jx->array(pti);
+    Array4<Real> const& jy_arr = jy->array(pti);
+    Array4<Real> const& jz_arr = jz->array(pti);
+#else
+    // Tiling is on: deposit in local_jx[thread_num] (same for jy and jz)
+    tbx.grow(ngJ);
+    tby.grow(ngJ);
+    tbz.grow(ngJ);
+
+    local_jx[thread_num].resize(tbx);
+    local_jy[thread_num].resize(tby);
+    local_jz[thread_num].resize(tbz);
+
+    local_jx[thread_num].setVal(0.0);
+    local_jy[thread_num].setVal(0.0);
+    local_jz[thread_num].setVal(0.0);
+
+    Array4<Real> const& jx_arr = local_jx[thread_num].array();
+    Array4<Real> const& jy_arr = local_jy[thread_num].array();
+    Array4<Real> const& jz_arr = local_jz[thread_num].array();
+#endif
+    const std::array<Real,3>& xyzmin_depos = WarpX::LowerCorner(tilebox, lev);
+    const Dim3 lo_depos = lbound(tilebox);
+
+    const Array4<const Real>& ex_arr = exfab->array();
+    const Array4<const Real>& ey_arr = eyfab->array();
+    const Array4<const Real>& ez_arr = ezfab->array();
+    const Array4<const Real>& bx_arr = bxfab->array();
+    const Array4<const Real>& by_arr = byfab->array();
+    const Array4<const Real>& bz_arr = bzfab->array();
+
+    // Particle quantities. The positions are read from and
+    // written to the particle structs directly.
+    auto& attribs = pti.GetAttribs();
+    const GetParticlePosition getPosition(pti);
+    const SetParticlePosition setPosition(pti);
+    const Real* const wp = attribs[PIdx::w].dataPtr();
+    Real* const uxp = attribs[PIdx::ux].dataPtr();
+    Real* const uyp = attribs[PIdx::uy].dataPtr();
+    Real* const uzp = attribs[PIdx::uz].dataPtr();
+
+    // Only write the fields on the particles if they are stored
+    Real *Exp = nullptr, *Eyp = nullptr, *Ezp = nullptr;
+    Real *Bxp = nullptr, *Byp = nullptr, *Bzp = nullptr;
+    if (save_fields_on_particles) {
+        Exp = pti.GetAttribs(particle_comps["Ex"]).dataPtr();
+        Eyp = pti.GetAttribs(particle_comps["Ey"]).dataPtr();
+        Ezp = pti.GetAttribs(particle_comps["Ez"]).dataPtr();
+        Bxp = pti.GetAttribs(particle_comps["Bx"]).dataPtr();
+        Byp = pti.GetAttribs(particle_comps["By"]).dataPtr();
+        Bzp = pti.GetAttribs(particle_comps["Bz"]).dataPtr();
+    }
+
+    // Save the old positions and momenta for back-transformed diagnostics
+    Real *xpold = nullptr, *ypold = nullptr, *zpold = nullptr;
+    Real *uxpold = nullptr, *uypold = nullptr, *uzpold = nullptr;
+    if (WarpX::do_boosted_frame_diagnostic && do_boosted_frame_diags) {
+        xpold = pti.GetAttribs(particle_comps["xold"]).dataPtr();
+        ypold = pti.GetAttribs(particle_comps["yold"]).dataPtr();
+        zpold = pti.GetAttribs(particle_comps["zold"]).dataPtr();
+        uxpold = pti.GetAttribs(particle_comps["uxold"]).dataPtr();
+        uypold = pti.GetAttribs(particle_comps["uyold"]).dataPtr();
+        uzpold = pti.GetAttribs(particle_comps["uzold"]).dataPtr();
+    }
+
+    const Real q = this->charge;
+    const Real m = this->mass;
+    const long pusher_algo = WarpX::particle_pusher_algo;
+    const long depos_algo = WarpX::current_deposition_algo;
+
+    // Depending on l_lower_in_v and WarpX::nox, call
+    // different versions of template function doFusedGatherPushDepositShapeN
+    const auto fusedGatherPushDeposit =
+        getFusedGatherPushDepositShapeN(WarpX::nox, WarpX::l_lower_order_in_v);
+    fusedGatherPushDeposit(
+        getPosition, setPosition, wp, uxp, uyp, uzp,
+        Exp, Eyp, Ezp, Bxp, Byp, Bzp,
+        xpold, ypold, zpold, uxpold, uypold, uzpold,
+        ex_arr, ey_arr, ez_arr, bx_arr, by_arr, bz_arr,
+        jx_arr, jy_arr, jz_arr, np, dt, dx,
+        xyzmin_gather, lo_gather, xyzmin_depos, lo_depos,
+        gather_stagger_shift, depos_stagger_shift,
+        q, m, pusher_algo, depos_algo);
+
+#ifndef AMREX_USE_GPU
+    BL_PROFILE_VAR_START(blp_accumulate);
+    // CPU, tiling: atomicAdd local_jx into jx
+    // (same for jx and jz)
+    (*jx)[pti].atomicAdd(local_jx[thread_num], tbx, tbx, 0, 0, 1);
+    (*jy)[pti].atomicAdd(local_jy[thread_num], tby, tby, 0, 0, 1);
+    (*jz)[pti].atomicAdd(local_jz[thread_num], tbz, tbz, 0, 0, 1);
+    BL_PROFILE_VAR_STOP(blp_accumulate);
+#endif
+}
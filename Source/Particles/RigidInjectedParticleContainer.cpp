@@ -13,6 +13,7 @@
 #include <WarpXAlgorithmSelection.H>
 #include <UpdateMomentumBoris.H>
 #include <UpdateMomentumVay.H>
+#include <GetAndSetPosition.H>
 
 using namespace amrex;
 
@@ -28,6 +29,9 @@ RigidInjectedParticleContainer::RigidInjectedParticleContainer (AmrCore* amr_cor
     pp.query("focused", focused);
     pp.query("rigid_advance", rigid_advance);
 
+    // PushPX is overridden to rescale the fields near the injection plane
+    allow_fused_gather_push_deposit = false;
+
 }
 
 void RigidInjectedParticleContainer::InitData()
@@ -207,12 +211,13 @@ RigidInjectedParticleContainer::BoostandRemapParticles()
 
 void
 RigidInjectedParticleContainer::PushPX(WarpXParIter& pti,
-                                       Cuda::ManagedDeviceVector<Real>& xp,
-                                       Cuda::ManagedDeviceVector<Real>& yp,
-                                       Cuda::ManagedDeviceVector<Real>& zp,
                                        Cuda::ManagedDeviceVector<Real>& giv,
-                                       Real dt)
+                                       RealVector& Exp_vec, RealVector& Eyp_vec,
+                                       RealVector& Ezp_vec, RealVector& Bxp_vec,
+                                       RealVector& Byp_vec, RealVector& Bzp_vec,
+                                       Real dt, long offset, long np_to_push)
 {
+    AMREX_ALWAYS_ASSERT(offset == 0 && np_to_push == pti.numParticles());
 
     // This wraps the momentum and position advance so that inheritors can modify the call.
     auto& attribs = pti.GetAttribs();
@@ -224,26 +229,35 @@ RigidInjectedParticleContainer::PushPX(WarpXParIter& pti,
     Cuda::ManagedDeviceVector<Real> xp_save, yp_save, zp_save;
     RealVector uxp_save, uyp_save, uzp_save;
 
-    Real* const AMREX_RESTRICT x = xp.dataPtr();
-    Real* const AMREX_RESTRICT y = yp.dataPtr();
-    Real* const AMREX_RESTRICT z = zp.dataPtr();
+    // Positions are read and written in place in the particle structs
+    const GetParticlePosition getPosition(pti);
+    const SetParticlePosition setPosition(pti);
     Real* const AMREX_RESTRICT gi = giv.dataPtr();
     Real* const AMREX_RESTRICT ux = uxp.dataPtr();
     Real* const AMREX_RESTRICT uy = uyp.dataPtr();
     Real* const AMREX_RESTRICT uz = uzp.dataPtr();
-    Real* const AMREX_RESTRICT Exp = attribs[PIdx::Ex].dataPtr();
-    Real* const AMREX_RESTRICT Eyp = attribs[PIdx::Ey].dataPtr();
-    Real* const AMREX_RESTRICT Ezp = attribs[PIdx::Ez].dataPtr();
-    Real* const AMREX_RESTRICT Bxp = attribs[PIdx::Bx].dataPtr();
-    Real* const AMREX_RESTRICT Byp = attribs[PIdx::By].dataPtr();
-    Real* const AMREX_RESTRICT Bzp = attribs[PIdx::Bz].dataPtr();
+    Real* const AMREX_RESTRICT Exp = Exp_vec.dataPtr();
+    Real* const AMREX_RESTRICT Eyp = Eyp_vec.dataPtr();
+    Real* const AMREX_RESTRICT Ezp = Ezp_vec.dataPtr();
+    Real* const AMREX_RESTRICT Bxp = Bxp_vec.dataPtr();
+    Real* const AMREX_RESTRICT Byp = Byp_vec.dataPtr();
+    Real* const AMREX_RESTRICT Bzp = Bzp_vec.dataPtr();
 
     if (!done_injecting_lev) {
         if (!(WarpX::do_boosted_frame_diagnostic && do_boosted_frame_diags)) {
             // If the old values are not already saved, create copies here.
-            xp_save = xp;
-            yp_save = yp;
-            zp_save = zp;
+            const long np = pti.numParticles();
+            xp_save.resize(np);
+            yp_save.resize(np);
+            zp_save.resize(np);
+            Real* const AMREX_RESTRICT xs = xp_save.dataPtr();
+            Real* const AMREX_RESTRICT ys = yp_save.dataPtr();
+            Real* const AMREX_RESTRICT zs = zp_save.dataPtr();
+            amrex::ParallelFor( np,
+                [=] AMREX_GPU_DEVICE (long i) {
+                    getPosition(i, xs[i], ys[i], zs[i]);
+                }
+            );
             uxp_save = uxp;
             uyp_save = uyp;
             uzp_save = uzp;
@@ -258,7 +272,9 @@ RigidInjectedParticleContainer::PushPX(WarpXParIter& pti,
         const Real vz_ave_boosted = vzbeam_ave_boosted;
         amrex::ParallelFor( pti.numParticles(),
             [=] AMREX_GPU_DEVICE (long i) {
-            const Real dtscale = dt - (z_plane_previous - z[i])/(vz_ave_boosted + v_boost);
+            Real x, y, z;
+            getPosition(i, x, y, z);
+            const Real dtscale = dt - (z_plane_previous - z)/(vz_ave_boosted + v_boost);
             if (0. < dtscale && dtscale < dt) {
                 Exp[i] *= dtscale;
                 Eyp[i] *= dtscale;
@@ -271,7 +287,10 @@ RigidInjectedParticleContainer::PushPX(WarpXParIter& pti,
         );
     }
 
-    PhysicalParticleContainer::PushPX(pti, xp, yp, zp, giv, dt);
+    PhysicalParticleContainer::PushPX(pti, giv,
+                                      Exp_vec, Eyp_vec, Ezp_vec,
+                                      Bxp_vec, Byp_vec, Bzp_vec, dt,
+                                      offset, np_to_push);
 
     if (!done_injecting_lev) {
 
@@ -305,19 +324,22 @@ RigidInjectedParticleContainer::PushPX(WarpXParIter& pti,
         const Real inv_csq = 1./(PhysConst::c*PhysConst::c);
         amrex::ParallelFor( pti.numParticles(),
             [=] AMREX_GPU_DEVICE (long i) {
-            if (z[i] <= z_plane_lev) {
+            Real x, y, z;
+            getPosition(i, x, y, z);
+            if (z <= z_plane_lev) {
                 ux[i] = ux_save[i];
                 uy[i] = uy_save[i];
                 uz[i] = uz_save[i];
                 gi[i] = 1./std::sqrt(1. + (ux[i]*ux[i] + uy[i]*uy[i] + uz[i]*uz[i])*inv_csq);
-                x[i] = x_save[i];
-                y[i] = y_save[i];
+                x = x_save[i];
+                y = y_save[i];
                 if (rigid) {
-                    z[i] = z_save[i] + dt*vz_ave_boosted;
+                    z = z_save[i] + dt*vz_ave_boosted;
                 }
                 else {
-                    z[i] = z_save[i] + dt*uz[i]*gi[i];
+                    z = z_save[i] + dt*uz[i]*gi[i];
                 }
+                setPosition(i, x, y, z);
             }
         }
         );
@@ -333,8 +355,11 @@ RigidInjectedParticleContainer::Evolve (int lev,
                                         MultiFab* rho, MultiFab* crho,
                                         const MultiFab* cEx, const MultiFab* cEy, const MultiFab* cEz,
                                         const MultiFab* cBx, const MultiFab* cBy, const MultiFab* cBz,
-                                        Real t, Real dt)
+                                        Real t, Real dt, EvolveRegion region)
 {
+    // The rigid-injection push only handles whole tiles:
+    // all the particles are evolved once the guard cells are exchanged
+    if (region == EvolveRegion::Interior) return;
 
     // Update location of injection plane in the boosted frame
     zinject_plane_lev_previous = zinject_plane_levels[lev];
@@ -358,7 +383,7 @@ RigidInjectedParticleContainer::Evolve (int lev,
                                        rho, crho,
                                        cEx, cEy, cEz,
                                        cBx, cBy, cBz,
-                                       t, dt);
+                                       t, dt, EvolveRegion::All);
 }
 
 void
@@ -390,12 +415,15 @@ RigidInjectedParticleContainer::PushP (int lev, Real dt,
             auto& uxp = attribs[PIdx::ux];
             auto& uyp = attribs[PIdx::uy];
             auto& uzp = attribs[PIdx::uz];
-            auto& Exp = attribs[PIdx::Ex];
-            auto& Eyp = attribs[PIdx::Ey];
-            auto& Ezp = attribs[PIdx::Ez];
-            auto& Bxp = attribs[PIdx::Bx];
-            auto& Byp = attribs[PIdx::By];
-            auto& Bzp = attribs[PIdx::Bz];
+
+            // Fields on particles: attributes if saved, scratch otherwise
+            auto fields = GetFieldsOnParticles(pti, thread_num);
+            auto& Exp = *fields[0];
+            auto& Eyp = *fields[1];
+            auto& Ezp = *fields[2];
+            auto& Bxp = *fields[3];
+            auto& Byp = *fields[4];
+            auto& Bzp = *fields[5];
 
             const long np = pti.numParticles();
 
@@ -416,11 +444,6 @@ RigidInjectedParticleContainer::PushP (int lev, Real dt,
 
             m_giv[thread_num].resize(np);
 
-            //
-            // copy data from particle container to temp arrays
-            //
-            pti.GetPosition(m_xp[thread_num], m_yp[thread_num], m_zp[thread_num]);
-
             int e_is_nodal = Ex.is_nodal() and Ey.is_nodal() and Ez.is_nodal();
             FieldGather(pti, Exp, Eyp, Ezp, Bxp, Byp, Bzp,
                         &exfab, &eyfab, &ezfab, &bxfab, &byfab, &bzfab,
@@ -433,7 +456,7 @@ RigidInjectedParticleContainer::PushP (int lev, Real dt,
 
             // This wraps the momentum advance so that inheritors can modify the call.
             // Extract pointers to the different particle quantities
-            const Real* const AMREX_RESTRICT zp = m_zp[thread_num].dataPtr();
+            const GetParticlePosition getPosition(pti);
             Real* const AMREX_RESTRICT gi = m_giv[thread_num].dataPtr();
             Real* const AMREX_RESTRICT uxpp = uxp.dataPtr();
             Real* const AMREX_RESTRICT uypp = uyp.dataPtr();
@@ -475,7 +498,9 @@ RigidInjectedParticleContainer::PushP (int lev, Real dt,
             const Real zz = zinject_plane_levels[lev];
             amrex::ParallelFor( pti.numParticles(),
                 [=] AMREX_GPU_DEVICE (long i) {
-                if (zp[i] <= zz) {
+                Real x, y, z;
+                getPosition(i, x, y, z);
+                if (z <= zz) {
                     uxpp[i] = ux_save[i];
                     uypp[i] = uy_save[i];
                     uzpp[i] = uz_save[i];
@@ -1,4 +1,5 @@
 
+#include <algorithm>
 #include <limits>
 
 #include <MultiParticleContainer.H>
@@ -64,9 +65,6 @@ WarpXParticleContainer::WarpXParticleContainer (AmrCore* amr_core, int ispecies)
     : ParticleContainer<0,0,PIdx::nattribs>(amr_core->GetParGDB())
     , species_id(ispecies)
 {
-    for (unsigned int i = PIdx::Ex; i <= PIdx::Bz; ++i) {
-        communicate_real_comp[i] = false; // Don't need to communicate E and B.
-    }
     SetParticleSize();
     ReadParameters();
 
@@ -75,12 +73,6 @@ WarpXParticleContainer::WarpXParticleContainer (AmrCore* amr_core, int ispecies)
     particle_comps["ux"] = PIdx::ux;
     particle_comps["uy"] = PIdx::uy;
     particle_comps["uz"] = PIdx::uz;
-    particle_comps["Ex"] = PIdx::Ex;
-    particle_comps["Ey"] = PIdx::Ey;
-    particle_comps["Ez"] = PIdx::Ez;
-    particle_comps["Bx"] = PIdx::Bx;
-    particle_comps["By"] = PIdx::By;
-    particle_comps["Bz"] = PIdx::Bz;
 #ifdef WARPX_DIM_RZ
     particle_comps["theta"] = PIdx::theta;
 #endif
@@ -111,6 +103,12 @@ WarpXParticleContainer::WarpXParticleContainer (AmrCore* amr_core, int ispecies)
     m_yp.resize(num_threads);
     m_zp.resize(num_threads);
     m_giv.resize(num_threads);
+    m_Exp.resize(num_threads);
+    m_Eyp.resize(num_threads);
+    m_Ezp.resize(num_threads);
+    m_Bxp.resize(num_threads);
+    m_Byp.resize(num_threads);
+    m_Bzp.resize(num_threads);
 }
 
 void
@@ -142,6 +140,21 @@ WarpXParticleContainer::AllocData ()
     resizeData();
 }
 
+std::array<WarpXParticleContainer::RealVector*, 6>
+WarpXParticleContainer::GetFieldsOnParticles (WarpXParIter& pti, int thread_num)
+{
+    std::array<RealVector*, 6> fields;
+    if (save_fields_on_particles) {
+        for (int i = 0; i < 6; ++i) {
+            fields[i] = &pti.GetAttribs(particle_comps[ParticleStringNames::field_names[i]]);
+        }
+    } else {
+        fields = {{&m_Exp[thread_num], &m_Eyp[thread_num], &m_Ezp[thread_num],
+                   &m_Bxp[thread_num], &m_Byp[thread_num], &m_Bzp[thread_num]}};
+    }
+    return fields;
+}
+
 void
 WarpXParticleContainer::AddOneParticle (int lev, int grid, int tile,
                                         Real x, Real y, Real z,
@@ -174,6 +187,13 @@ WarpXParticleContainer::AddOneParticle (ParticleTileType& particle_tile,
 
     particle_tile.push_back(p);
     particle_tile.push_back_real(attribs);
+
+    if (save_fields_on_particles)
+    {
+        for (const auto& name : ParticleStringNames::field_names) {
+            particle_tile.push_back_real(particle_comps[name], 0.0);
+        }
+    }
 }
 
 void
@@ -203,10 +223,16 @@ WarpXParticleContainer::AddNParticles (int lev,
 	}
     }
 
-    //  Add to grid 0 and tile 0
-    // Redistribute() will move them to proper places.
-    std::pair<int,int> key {0,0};
-    auto& particle_tile = GetParticles(lev)[key];
+    // Add to grid 0 and tile 0 of pc_new.
+    // RedistributeNew() will move them to proper places.
+    NewParticleContainer pc_new(m_gdb);
+    for (int comp = PIdx::nattribs; comp < NumRealComps(); ++comp) {
+        pc_new.AddRealComp();
+    }
+    for (int comp = 0; comp < NumIntComps(); ++comp) {
+        pc_new.AddIntComp();
+    }
+    auto& particle_tile = pc_new.DefineAndReturnParticleTile(lev, 0, 0);
 
     std::size_t np = iend-ibegin;
 
@@ -240,10 +266,9 @@ WarpXParticleContainer::AddNParticles (int lev,
 
         if (WarpX::do_boosted_frame_diagnostic && do_boosted_frame_diags)
         {
-            auto& ptile = DefineAndReturnParticleTile(0, 0, 0);
-            ptile.push_back_real(particle_comps["xold"], x[i]);
-            ptile.push_back_real(particle_comps["yold"], y[i]);
-            ptile.push_back_real(particle_comps["zold"], z[i]);
+            particle_tile.push_back_real(particle_comps["xold"], x[i]);
+            particle_tile.push_back_real(particle_comps["yold"], y[i]);
+            particle_tile.push_back_real(particle_comps["zold"], z[i]);
         }
 
         particle_tile.push_back(p);
@@ -258,17 +283,23 @@ WarpXParticleContainer::AddNParticles (int lev,
 
         if (WarpX::do_boosted_frame_diagnostic && do_boosted_frame_diags)
         {
-            auto& ptile = DefineAndReturnParticleTile(0, 0, 0);
-            ptile.push_back_real(particle_comps["uxold"], vx + ibegin, vx + iend);
-            ptile.push_back_real(particle_comps["uyold"], vy + ibegin, vy + iend);
-            ptile.push_back_real(particle_comps["uzold"], vz + ibegin, vz + iend);
+            particle_tile.push_back_real(particle_comps["uxold"], vx + ibegin, vx + iend);
+            particle_tile.push_back_real(particle_comps["uyold"], vy + ibegin, vy + iend);
+            particle_tile.push_back_real(particle_comps["uzold"], vz + ibegin, vz + iend);
+        }
+
+        if (save_fields_on_particles)
+        {
+            for (const auto& name : ParticleStringNames::field_names) {
+                particle_tile.push_back_real(particle_comps[name], np, 0.0);
+            }
         }
 
         for (int comp = PIdx::uz+1; comp < PIdx::nattribs; ++comp)
         {
 #ifdef WARPX_DIM_RZ
             if (comp == PIdx::theta) {
-                particle_tile.push_back_real(comp, theta.front(), theta.back());
+                particle_tile.push_back_real(comp, theta.data(), theta.data() + np);
             }
             else {
                 particle_tile.push_back_real(comp, np, 0.0);
@@ -277,9 +308,89 @@ WarpXParticleContainer::AddNParticles (int lev,
             particle_tile.push_back_real(comp, np, 0.0);
 #endif
         }
+
+        for (int comp = 0; comp < NumIntComps(); ++comp)
+        {
+            particle_tile.push_back_int(comp, np, 0);
+        }
+    }
+
+    RedistributeNew(pc_new, lev);
+}
+
+void
+WarpXParticleContainer::RedistributeNew (NewParticleContainer& pc_new, int lev)
+{
+    BL_PROFILE("WarpXParticleContainer::RedistributeNew");
+
+    const int myproc = ParallelDescriptor::MyProc();
+
+    // Append the particles owned by a local tile to it, and invalidate
+    // them in pc_new
+    for (int src_lev = 0; src_lev <= pc_new.finestLevel(); ++src_lev)
+    {
+        for (auto& kv : pc_new.GetParticles(src_lev))
+        {
+            auto& src_tile = kv.second;
+            auto& aos = src_tile.GetArrayOfStructs();
+            for (long ip = 0, np = aos.size(); ip < np; ++ip)
+            {
+                ParticleType& p = aos[ip];
+                ParticleLocData pld;
+                if (Where(p, pld) and
+                    ParticleDistributionMap(pld.m_lev)[pld.m_grid] == myproc)
+                {
+                    AppendToOwnerTile(src_tile, ip, pld, lev);
+                    p.id() = -1;
+                }
+            }
+        }
     }
 
-    Redistribute();
+    // The others (owned by another rank, or outside of the domain, e.g.
+    // across a periodic boundary) go through a Redistribute of pc_new, if
+    // there are any on any rank.
+    if (pc_new.TotalNumberOfParticles() > 0)
+    {
+        pc_new.Redistribute();
+        for (int src_lev = 0; src_lev <= pc_new.finestLevel(); ++src_lev)
+        {
+            for (const auto& kv : pc_new.GetParticles(src_lev))
+            {
+                const auto& src_tile = kv.second;
+                const auto& aos = src_tile.GetArrayOfStructs();
+                for (long ip = 0, np = aos.size(); ip < np; ++ip)
+                {
+                    ParticleLocData pld;
+                    if (Where(aos[ip], pld)) {
+                        AppendToOwnerTile(src_tile, ip, pld, lev);
+                    }
+                }
+            }
+        }
+    }
+
+    pc_new.clearParticles();
+}
+
+void
+WarpXParticleContainer::AppendToOwnerTile (const ParticleTileType& src_tile, long ip,
+                                           const ParticleLocData& pld, int lev)
+{
+    auto& dst_tile = DefineAndReturnParticleTile(pld.m_lev, pld.m_grid, pld.m_tile);
+
+    // Same tagging as when the particle goes through Redistribute
+    ParticleType p = src_tile.GetArrayOfStructs()[ip];
+    particlePostLocate(p, pld, lev);
+    dst_tile.push_back(p);
+
+    const auto& soa = src_tile.GetStructOfArrays();
+    for (int comp = 0; comp < NumRealComps(); ++comp) {
+        dst_tile.push_back_real(comp, soa.GetRealData(comp)[ip]);
+    }
+    for (int comp = 0; comp < NumIntComps(); ++comp) {
+        dst_tile.push_back_int(comp, soa.GetIntData(comp)[ip]);
+    }
 }
 
 /* \brief Current Deposition for thread thread_num using PICSAR
@@ -491,9 +602,8 @@ WarpXParticleContainer::DepositCurrent(WarpXParIter& pti,
     // CPU, tiling: deposit into local_jx
     // (same for jx and jz)
 
-    Real* AMREX_RESTRICT xp = m_xp[thread_num].dataPtr() + offset;
-    Real* AMREX_RESTRICT zp = m_zp[thread_num].dataPtr() + offset;
-    Real* AMREX_RESTRICT yp = m_yp[thread_num].dataPtr() + offset;
+    // Positions are read in place from the particle structs
+    const GetParticlePosition getPosition(pti, offset);
 
     // Lower corner of tile box physical domain
     // Note that this includes guard cells since it is after tilebox.ngrow
@@ -507,34 +617,55 @@ WarpXParticleContainer::DepositCurrent(WarpXParIter& pti,
 
     if (WarpX::current_deposition_algo == CurrentDepositionAlgo::Esirkepov) {
         if        (WarpX::nox == 1){
-            doEsirkepovDepositionShapeN<1>(xp, yp, zp, wp.dataPtr() + offset, uxp.dataPtr() + offset, 
+            doEsirkepovDepositionShapeN<1>(getPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset, 
                                            uyp.dataPtr() + offset, uzp.dataPtr() + offset, jx_arr, jy_arr, 
                                            jz_arr, np_to_depose, dt, dx,
                                            xyzmin, lo, q);
         } else if (WarpX::nox == 2){
-            doEsirkepovDepositionShapeN<2>(xp, yp, zp, wp.dataPtr() + offset, uxp.dataPtr() + offset, 
+            doEsirkepovDepositionShapeN<2>(getPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset, 
                                            uyp.dataPtr() + offset, uzp.dataPtr() + offset, jx_arr, jy_arr, 
                                            jz_arr, np_to_depose, dt, dx,
                                            xyzmin, lo, q);
         } else if (WarpX::nox == 3){
-            doEsirkepovDepositionShapeN<3>(xp, yp, zp, wp.dataPtr() + offset, uxp.dataPtr() + offset, 
+            doEsirkepovDepositionShapeN<3>(getPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset, 
                                            uyp.dataPtr() + offset, uzp.dataPtr() + offset, jx_arr, jy_arr, 
                                            jz_arr, np_to_depose, dt, dx,
                                            xyzmin, lo, q);
         }
+#if (!defined AMREX_USE_GPU) && (!defined WARPX_DIM_RZ)
+    } else if (WarpX::current_deposition_algo == CurrentDepositionAlgo::DirectSupercell) {
+        // Chunks of particles in the same bin are deposited without atomics
+        // (the bins of warpx.sort_bin_size are the supercells)
+        if        (WarpX::nox == 1){
+            doDepositionSupercellShapeN<1>(getPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                                           uyp.dataPtr() + offset, uzp.dataPtr() + offset, jx_arr, jy_arr,
+                                           jz_arr, np_to_depose, dt, dx,
+                                           xyzmin, lo, stagger_shift, q, WarpX::sort_bin_size);
+        } else if (WarpX::nox == 2){
+            doDepositionSupercellShapeN<2>(getPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                                           uyp.dataPtr() + offset, uzp.dataPtr() + offset, jx_arr, jy_arr,
+                                           jz_arr, np_to_depose, dt, dx,
+                                           xyzmin, lo, stagger_shift, q, WarpX::sort_bin_size);
+        } else if (WarpX::nox == 3){
+            doDepositionSupercellShapeN<3>(getPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                                           uyp.dataPtr() + offset, uzp.dataPtr() + offset, jx_arr, jy_arr,
+                                           jz_arr, np_to_depose, dt, dx,
+                                           xyzmin, lo, stagger_shift, q, WarpX::sort_bin_size);
+        }
+#endif
     } else {
         if        (WarpX::nox == 1){
-            doDepositionShapeN<1>(xp, yp, zp, wp.dataPtr() + offset, uxp.dataPtr() + offset, 
+            doDepositionShapeN<1>(getPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset, 
                                   uyp.dataPtr() + offset, uzp.dataPtr() + offset, jx_arr, jy_arr, 
                                   jz_arr, np_to_depose, dt, dx,
                                   xyzmin, lo, stagger_shift, q);
         } else if (WarpX::nox == 2){
-            doDepositionShapeN<2>(xp, yp, zp, wp.dataPtr() + offset, uxp.dataPtr() + offset, 
+            doDepositionShapeN<2>(getPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset, 
                                   uyp.dataPtr() + offset, uzp.dataPtr() + offset, jx_arr, jy_arr, 
                                   jz_arr, np_to_depose, dt, dx,
                                   xyzmin, lo, stagger_shift, q);
         } else if (WarpX::nox == 3){
-            doDepositionShapeN<3>(xp, yp, zp, wp.dataPtr() + offset, uxp.dataPtr() + offset, 
+            doDepositionShapeN<3>(getPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset, 
                                   uyp.dataPtr() + offset, uzp.dataPtr() + offset, jx_arr, jy_arr, 
                                   jz_arr, np_to_depose, dt, dx,
                                   xyzmin, lo, stagger_shift, q);
@@ -603,9 +734,8 @@ WarpXParticleContainer::DepositCharge (WarpXParIter& pti, RealVector& wp,
     // GPU, no tiling: deposit directly in rho
     // CPU, tiling: deposit into local_rho
 
-    Real* AMREX_RESTRICT xp = m_xp[thread_num].dataPtr() + offset;
-    Real* AMREX_RESTRICT zp = m_zp[thread_num].dataPtr() + offset;
-    Real* AMREX_RESTRICT yp = m_yp[thread_num].dataPtr() + offset;
+    // Positions are read in place from the particle structs
+    const GetParticlePosition getPosition(pti, offset);
 
     // Lower corner of tile box physical domain
     // Note that this includes guard cells since it is after tilebox.ngrow
@@ -615,13 +745,13 @@ WarpXParticleContainer::DepositCharge (WarpXParIter& pti, RealVector& wp,
 
     BL_PROFILE_VAR_START(blp_ppc_chd);
     if        (WarpX::nox == 1){
-        doChargeDepositionShapeN<1>(xp, yp, zp, wp.dataPtr()+offset, rho_arr,
+        doChargeDepositionShapeN<1>(getPosition, wp.dataPtr()+offset, rho_arr,
                                     np_to_depose, dx, xyzmin, lo, q);
     } else if (WarpX::nox == 2){
-        doChargeDepositionShapeN<2>(xp, yp, zp, wp.dataPtr()+offset, rho_arr,
+        doChargeDepositionShapeN<2>(getPosition, wp.dataPtr()+offset, rho_arr,
                                     np_to_depose, dx, xyzmin, lo, q);
     } else if (WarpX::nox == 3){
-        doChargeDepositionShapeN<3>(xp, yp, zp, wp.dataPtr()+offset, rho_arr,
+        doChargeDepositionShapeN<3>(getPosition, wp.dataPtr()+offset, rho_arr,
                                     np_to_depose, dx, xyzmin, lo, q);
     }
     BL_PROFILE_VAR_STOP(blp_ppc_chd);
@@ -730,8 +860,6 @@ WarpXParticleContainer::GetChargeDensity (int lev, bool local)
             const long np = pti.numParticles();
             auto& wp = pti.GetAttribs(PIdx::w);
 
-            pti.GetPosition(m_xp[thread_num], m_yp[thread_num], m_zp[thread_num]);
-
             DepositCharge(pti, wp, rho.get(), 0, 0, np, thread_num, lev, lev);
         }
 #ifdef _OPENMP
@@ -949,6 +1077,129 @@ WarpXParticleContainer::PushX (int lev, Real dt)
     }
 }
 
+Box
+WarpXParticleContainer::InteriorGatherBox (const WarpXParIter& pti) const
+{
+    // The gather stencil of a particle of order n extends at most
+    // n+1 cells on each side of the cell that contains it
+#if (AMREX_SPACEDIM == 3)
+    const IntVect shrink(WarpX::nox+1, WarpX::noy+1, WarpX::noz+1);
+#else
+    const IntVect shrink(WarpX::nox+1, WarpX::noz+1);
+#endif
+    return amrex::grow(pti.validbox(), -shrink);
+}
+
+void
+WarpXParticleContainer::SortParticlesByBin (amrex::IntVect bin_size, bool interior_first)
+{
+    BL_PROFILE("WPC::SortParticlesByBin()");
+
+    sort_bin_offsets.resize(finestLevel()+1);
+
+    for (int lev = 0; lev <= finestLevel(); ++lev)
+    {
+        // First touch the offsets of all the tiles in serial
+        auto& offsets_map = sort_bin_offsets[lev];
+        for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti) {
+            offsets_map[std::make_pair(pti.index(), pti.LocalTileIndex())];
+        }
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            Vector<long> key;
+            Vector<long> bin_count;
+            Vector<long> perm;
+            ParticleVector particle_tmp;
+            RealVector real_tmp;
+            IntVector int_tmp;
+
+            for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
+            {
+                auto& offsets = offsets_map.at(std::make_pair(pti.index(), pti.LocalTileIndex()));
+                const long np = pti.numParticles();
+
+                const Box& tbx = pti.tilebox();
+                const Box bin_box = amrex::coarsen(tbx, bin_size);
+                const long nbins = bin_box.numPts();
+                const long nkeys = interior_first ? 2*nbins : nbins;
+                const Box interior_box = interior_first ? InteriorGatherBox(pti) : Box();
+                auto& aos = pti.GetArrayOfStructs();
+
+                // Sort key of each particle: its bin, after the bins of the
+                // interior particles if interior_first
+                key.resize(np);
+                for (long ip = 0; ip < np; ++ip) {
+                    const IntVect iv = Index(aos[ip], lev);
+                    IntVect ivc = iv;
+                    ivc.max(tbx.smallEnd());
+                    ivc.min(tbx.bigEnd());
+                    key[ip] = bin_box.index(amrex::coarsen(ivc, bin_size));
+                    if (interior_first && !interior_box.contains(iv)) key[ip] += nbins;
+                }
+
+                // First slot from which the tile is re-sorted. Before it,
+                // all the particles are still in the bin range of their slot
+                // and no particle of a lower key has to be inserted.
+                long first = 0;
+                if (offsets.size() == nkeys+1)
+                {
+                    const long np_sorted = std::min(np, offsets[nkeys]);
+                    long first_moved = np_sorted;
+                    long kmin = nkeys; // Lowest key of the particles to move
+                    long k = 0;
+                    for (long ip = 0; ip < np_sorted; ++ip) {
+                        while (offsets[k+1] <= ip) ++k;
+                        if (key[ip] != k) {
+                            if (first_moved == np_sorted) first_moved = ip;
+                            kmin = std::min(kmin, key[ip]);
+                        }
+                    }
+                    // Particles added since the last sort
+                    for (long ip = np_sorted; ip < np; ++ip) {
+                        kmin = std::min(kmin, key[ip]);
+                    }
+                    first = (kmin < nkeys) ? std::min(first_moved, offsets[kmin]) : first_moved;
+                }
+
+                offsets.assign(nkeys+1, 0);
+                for (long ip = 0; ip < np; ++ip) ++offsets[key[ip]+1];
+                for (long ik = 0; ik < nkeys; ++ik) offsets[ik+1] += offsets[ik];
+
+                if (first >= np) continue;
+
+                // Stable counting sort of the particles [first, np)
+                const long ntail = np - first;
+                bin_count.assign(nkeys+1, 0);
+                for (long ip = first; ip < np; ++ip) ++bin_count[key[ip]+1];
+                for (long ik = 0; ik < nkeys; ++ik) bin_count[ik+1] += bin_count[ik];
+                perm.resize(ntail);
+                for (long ip = first; ip < np; ++ip) perm[bin_count[key[ip]]++] = ip;
+
+                particle_tmp.resize(ntail);
+                for (long i = 0; i < ntail; ++i) particle_tmp[i] = aos[perm[i]];
+                std::copy(particle_tmp.begin(), particle_tmp.end(), &aos[first]);
+
+                real_tmp.resize(ntail);
+                for (int comp = 0; comp < NumRealComps(); ++comp) {
+                    auto& attrib = pti.GetAttribs(comp);
+                    for (long i = 0; i < ntail; ++i) real_tmp[i] = attrib[perm[i]];
+                    std::copy(real_tmp.begin(), real_tmp.end(), attrib.dataPtr() + first);
+                }
+                auto& soa = pti.GetStructOfArrays();
+                int_tmp.resize(ntail);
+                for (int comp = 0; comp < NumIntComps(); ++comp) {
+                    auto& attrib = soa.GetIntData(comp);
+                    for (long i = 0; i < ntail; ++i) int_tmp[i] = attrib[perm[i]];
+                    std::copy(int_tmp.begin(), int_tmp.end(), attrib.dataPtr() + first);
+                }
+            }
+        }
+    }
+}
+
 // This function is called in Redistribute, just after locate
 void
 WarpXParticleContainer::particlePostLocate(ParticleType& p,
@@ -356,6 +356,12 @@ extern "C"
         return data;
     }
 
+    int warpx_getParticleCompIndex(int speciesnumber, const char* comp_name) {
+        auto & mypc = WarpX::GetInstance().GetPartContainer();
+        auto & myspc = mypc.GetParticleContainer(speciesnumber);
+        return myspc.getParticleComp(comp_name);
+    }
+
     void warpx_ComputeDt () {
         WarpX& warpx = WarpX::GetInstance();
         warpx.ComputeDt ();
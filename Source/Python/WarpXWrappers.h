@@ -85,6 +85,8 @@ extern "C" {
     double** warpx_getParticleArrays(int speciesnumber, int comp,
                                      int* num_tiles, int** particles_per_tile);
 
+    int warpx_getParticleCompIndex(int speciesnumber, const char* comp_name);
+
   void warpx_ComputeDt ();
   void warpx_MoveWindow ();
 
@@ -25,6 +25,9 @@ const std::map<std::string, int> current_deposition_algo_to_int = {
     {"direct",               CurrentDepositionAlgo::Direct },
 #if (!defined AMREX_USE_GPU)&&(AMREX_SPACEDIM == 3) // Only available on CPU and 3D
     {"direct-vectorized",    CurrentDepositionAlgo::DirectVectorized },
+#endif
+#if (!defined AMREX_USE_GPU)&&(!defined WARPX_DIM_RZ) // Only available on CPU, not in RZ
+    {"direct-supercell",     CurrentDepositionAlgo::DirectSupercell },
 #endif
     {"default",              CurrentDepositionAlgo::Esirkepov }
 };
@@ -44,6 +47,12 @@ const std::map<std::string, int> gathering_algo_to_int = {
 #endif
 };
 
+const std::map<std::string, int> load_balance_costs_update_algo_to_int = {
+    {"timers",     LoadBalanceCostsUpdateAlgo::Timers },
+    {"heuristic",  LoadBalanceCostsUpdateAlgo::Heuristic },
+    {"calibrated", LoadBalanceCostsUpdateAlgo::Calibrated },
+    {"default",    LoadBalanceCostsUpdateAlgo::Timers }
+};
 
 int
 GetAlgorithmInteger( amrex::ParmParse& pp, const char* pp_search_key ){
@@ -66,6 +75,8 @@ GetAlgorithmInteger( amrex::ParmParse& pp, const char* pp_search_key ){
         algo_to_int = charge_deposition_algo_to_int;
     } else if (0 == std::strcmp(pp_search_key, "field_gathering")) {
         algo_to_int = gathering_algo_to_int;
+    } else if (0 == std::strcmp(pp_search_key, "load_balance_costs_update")) {
+        algo_to_int = load_balance_costs_update_algo_to_int;
     } else {
         std::string pp_search_string = pp_search_key;
         amrex::Abort("Unknown algorithm type: " + pp_search_string);
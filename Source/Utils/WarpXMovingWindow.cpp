@@ -208,15 +208,16 @@ WarpX::shiftMF (MultiFab& mf, const Geometry& geom, int num_shift, int dir)
 {
     BL_PROFILE("WarpX::shiftMF()");
     const BoxArray& ba = mf.boxArray();
-    const DistributionMapping& dm = mf.DistributionMap();
     const int nc = mf.nComp();
     const IntVect& ng = mf.nGrowVect();
 
     AMREX_ALWAYS_ASSERT(ng.min() >= num_shift);
 
-    MultiFab tmpmf(ba, dm, nc, ng);
-    MultiFab::Copy(tmpmf, mf, 0, 0, nc, ng);
-    tmpmf.FillBoundary(geom.periodicity());
+    // The shift is done in place: after FillBoundary, the guard cells of
+    // each box hold the data of its neighbors, and the cells are moved by
+    // num_shift along dir, in the order in which each source cell is read
+    // before it is overwritten. This avoids a full-size temporary MultiFab.
+    mf.FillBoundary(geom.periodicity());
 
     // Make a box that covers the region that the window moved into
     const IndexType& typ = ba.ixType();
@@ -249,16 +250,15 @@ WarpX::shiftMF (MultiFab& mf, const Geometry& geom, int num_shift, int dir)
 #ifdef _OPENMP
 #pragma omp parallel if (Gpu::notInLaunchRegion())
 #endif
-    for (MFIter mfi(tmpmf); mfi.isValid(); ++mfi )
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi )
     {
-        auto const& dstfab = mf.array(mfi);
-        auto const& srcfab = tmpmf.array(mfi);
+        auto const& fab = mf.array(mfi);
 
         const Box& outbox = mfi.fabbox() & adjBox;
         if (outbox.ok()) {
             AMREX_PARALLEL_FOR_4D ( outbox, nc, i, j, k, n,
             {
-                srcfab(i,j,k,n) = 0.0;
+                fab(i,j,k,n) = 0.0;
             });
         }
 
@@ -268,10 +268,46 @@ WarpX::shiftMF (MultiFab& mf, const Geometry& geom, int num_shift, int dir)
         } else {
             dstBox.growLo(dir,  num_shift);
         }
-        AMREX_PARALLEL_FOR_4D ( dstBox, nc, i, j, k, n,
+#ifdef AMREX_USE_GPU
+        // Each line along dir is shifted by one thread, so that the
+        // lines are independent of each other.
+        const int nline = dstBox.length(dir);
+        Box linebox = dstBox;
+        linebox.setBig(dir, dstBox.smallEnd(dir));
+        AMREX_PARALLEL_FOR_4D ( linebox, nc, i0, j0, k0, n,
         {
-            dstfab(i,j,k,n) = srcfab(i+shift.x,j+shift.y,k+shift.z,n);
+            for (int l = 0; l < nline; ++l) {
+                const int m = (num_shift > 0) ? l : nline-1-l;
+                const int i = (dir == 0) ? i0+m : i0;
+                const int j = (dir == 1) ? j0+m : j0;
+                const int k = (dir == 2) ? k0+m : k0;
+                fab(i,j,k,n) = fab(i+shift.x,j+shift.y,k+shift.z,n);
+            }
         });
+#else
+        // Traverse the box in increasing order for a positive shift
+        // (cells are read ahead of the ones written), and in decreasing
+        // order for a negative shift.
+        const Dim3 lo = amrex::lbound(dstBox);
+        const Dim3 hi = amrex::ubound(dstBox);
+        if (num_shift > 0) {
+            for (int n = 0; n < nc; ++n) {
+                for (int k = lo.z; k <= hi.z; ++k) {
+                for (int j = lo.y; j <= hi.y; ++j) {
+                for (int i = lo.x; i <= hi.x; ++i) {
+                    fab(i,j,k,n) = fab(i+shift.x,j+shift.y,k+shift.z,n);
+                }}}
+            }
+        } else {
+            for (int n = 0; n < nc; ++n) {
+                for (int k = hi.z; k >= lo.z; --k) {
+                for (int j = hi.y; j >= lo.y; --j) {
+                for (int i = hi.x; i >= lo.x; --i) {
+                    fab(i,j,k,n) = fab(i+shift.x,j+shift.y,k+shift.z,n);
+                }}}
+            }
+        }
+#endif
     }
 }
 
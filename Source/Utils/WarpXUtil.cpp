@@ -1,3 +1,4 @@
+#include <cctype>
 #include <cmath>
 
 #include <WarpXUtil.H>
@@ -152,3 +153,56 @@ void NullifyMF(amrex::MultiFab& mf, int lev, amrex::Real zmin, amrex::Real zmax)
         }
     }
 }
+
+void MakeParserFromInput (WarpXParser& parser, std::string const& expr,
+                          std::vector<std::string> const& varnames)
+{
+    ParmParse pp("my_constants");
+
+    // User-defined functions, e.g. my_constants.functions = ramp(z)
+    // with my_constants.ramp(z) = "(z>z0)*(z-z0)/L"
+    std::vector<std::string> signatures;
+    pp.queryarr("functions", signatures);
+    for (auto const& sig : signatures) {
+        const auto open = sig.find('(');
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(
+            open != std::string::npos && open > 0 && sig.back() == ')',
+            "my_constants.functions: expected name(arg1,arg2,...), got " + sig);
+        std::vector<std::string> args(1);
+        for (std::size_t i = open+1; i+1 < sig.size(); ++i) {
+            if (sig[i] == ',') {
+                args.emplace_back();
+            } else if (!std::isspace(sig[i])) {
+                args.back() += sig[i];
+            }
+        }
+        if (args.size() == 1 && args[0].empty()) args.clear();
+        std::vector<std::string> f;
+        pp.getarr(sig.c_str(), f);
+        std::string body;
+        for (auto const& s : f) {
+            body += s;
+        }
+        parser.defineFunction(sig.substr(0, open), args, body);
+    }
+
+    parser.define(expr);
+    parser.registerVariables(varnames);
+
+    std::set<std::string> symbols = parser.symbols();
+    for (auto const& v : varnames) {
+        symbols.erase(v);
+    } // after removing variables, we are left with constants
+    for (auto it = symbols.begin(); it != symbols.end(); ) {
+        Real v;
+        if (pp.query(it->c_str(), v)) {
+            parser.setConstant(*it, v);
+            it = symbols.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for (auto const& s : symbols) { // make sure there no unknown symbols
+        amrex::Abort("Unknown symbol "+s+" in expression "+expr);
+    }
+}
@@ -43,6 +43,8 @@ long WarpX::charge_deposition_algo;
 long WarpX::field_gathering_algo;
 long WarpX::particle_pusher_algo;
 int WarpX::maxwell_fdtd_solver_id;
+int WarpX::load_balance_costs_update_algo;
+bool WarpX::fused_gather_push_deposit = false;
 
 long WarpX::nox = 1;
 long WarpX::noy = 1;
@@ -52,12 +54,15 @@ bool WarpX::use_fdtd_nci_corr = false;
 int  WarpX::l_lower_order_in_v = true;
 
 bool WarpX::use_filter        = false;
+bool WarpX::use_separable_filter = true;
 bool WarpX::serialize_ics     = false;
 bool WarpX::refine_plasma     = false;
 
 int WarpX::num_mirrors = 0;
 
 int  WarpX::sort_int = -1;
+int  WarpX::sort_incremental = 0;
+IntVect WarpX::sort_bin_size(AMREX_D_DECL(1,1,1));
 
 bool WarpX::do_boosted_frame_diagnostic = false;
 std::string WarpX::lab_data_directory = "lab_frame_data";
@@ -182,6 +187,8 @@ WarpX::WarpX ()
 
     Efield_cax.resize(nlevs_max);
     Bfield_cax.resize(nlevs_max);
+    Efield_cdiff.resize(nlevs_max);
+    Bfield_cdiff.resize(nlevs_max);
     current_buffer_masks.resize(nlevs_max);
     gather_buffer_masks.resize(nlevs_max);
     current_buf.resize(nlevs_max);
@@ -201,6 +208,14 @@ WarpX::WarpX ()
 
     costs.resize(nlevs_max);
 
+    int num_threads = 1;
+#ifdef _OPENMP
+#pragma omp parallel
+#pragma omp single
+    num_threads = omp_get_num_threads();
+#endif
+    aux_interp_fab.resize(num_threads);
+
 #ifdef WARPX_USE_PSATD
     spectral_solver_fp.resize(nlevs_max);
     spectral_solver_cp.resize(nlevs_max);
@@ -348,6 +363,7 @@ WarpX::ReadParameters ()
     }
 
     pp.query("do_electrostatic", do_electrostatic);
+    pp.query("es_ascii_particle_int", es_ascii_particle_int);
     pp.query("n_buffer", n_buffer);
     pp.query("const_dt", const_dt);
 
@@ -361,6 +377,7 @@ WarpX::ReadParameters ()
 #if (AMREX_SPACEDIM == 3)
     filter_npass_each_dir[2] = parse_filter_npass_each_dir[2];
 #endif
+    pp.query("use_separable_filter", use_separable_filter);
 
     pp.query("num_mirrors", num_mirrors);
     if (num_mirrors>0){
@@ -378,6 +395,13 @@ WarpX::ReadParameters ()
         pp.query("n_field_gather_buffer", n_field_gather_buffer);
         pp.query("n_current_deposition_buffer", n_current_deposition_buffer);
 	pp.query("sort_int", sort_int);
+        pp.query("sort_incremental", sort_incremental);
+        Vector<int> bin_size;
+        if (pp.queryarr("sort_bin_size", bin_size)) {
+            AMREX_ALWAYS_ASSERT_WITH_MESSAGE(bin_size.size() == AMREX_SPACEDIM,
+                "warpx.sort_bin_size must have AMREX_SPACEDIM values");
+            sort_bin_size = IntVect(bin_size);
+        }
 
         pp.query("do_pml", do_pml);
         pp.query("pml_ncell", pml_ncell);
@@ -398,6 +422,25 @@ WarpX::ReadParameters ()
         do_pml_Hi[2] = parse_do_pml_Hi[2];
 #endif
 
+        pp.query("do_comm_avoiding_fdtd", do_comm_avoiding_fdtd);
+        if (do_comm_avoiding_fdtd) {
+            AMREX_ALWAYS_ASSERT_WITH_MESSAGE(maxLevel() == 0 && !do_pml && !do_dive_cleaning,
+                "warpx.do_comm_avoiding_fdtd requires amr.max_level = 0, "
+                "warpx.do_pml = 0 and warpx.do_dive_cleaning = 0");
+        }
+
+        pp.query("overlap_fillboundary_push", overlap_fillboundary_push);
+        if (overlap_fillboundary_push) {
+            AMREX_ALWAYS_ASSERT_WITH_MESSAGE(maxLevel() == 0,
+                "warpx.overlap_fillboundary_push requires amr.max_level = 0");
+        }
+
+        pp.query("overlap_sumboundary_j", overlap_sumboundary_j);
+        if (overlap_sumboundary_j) {
+            AMREX_ALWAYS_ASSERT_WITH_MESSAGE(maxLevel() == 0,
+                "warpx.overlap_sumboundary_j requires amr.max_level = 0");
+        }
+
 
         pp.query("dump_openpmd", dump_openpmd);
         pp.query("dump_plotfiles", dump_plotfiles);
@@ -481,6 +524,12 @@ WarpX::ReadParameters ()
         pp.query("load_balance_int", load_balance_int);
         pp.query("load_balance_with_sfc", load_balance_with_sfc);
         pp.query("load_balance_knapsack_factor", load_balance_knapsack_factor);
+        pp.query("load_balance_efficiency_ratio_threshold",
+                 load_balance_efficiency_ratio_threshold);
+        pp.query("load_balance_incremental", load_balance_incremental);
+        pp.query("load_balance_imbalance_tolerance", load_balance_imbalance_tolerance);
+        pp.query("costs_heuristic_particles_wt", costs_heuristic_particles_wt);
+        pp.query("costs_heuristic_cells_wt", costs_heuristic_cells_wt);
 
         pp.query("do_dynamic_scheduling", do_dynamic_scheduling);
 
@@ -521,6 +570,16 @@ WarpX::ReadParameters ()
         field_gathering_algo = GetAlgorithmInteger(pp, "field_gathering");
         particle_pusher_algo = GetAlgorithmInteger(pp, "particle_pusher");
         maxwell_fdtd_solver_id = GetAlgorithmInteger(pp, "maxwell_fdtd_solver");
+        load_balance_costs_update_algo = GetAlgorithmInteger(pp, "load_balance_costs_update");
+        pp.query("fused_gather_push_deposit", fused_gather_push_deposit);
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE( !fused_gather_push_deposit || !use_picsar_deposition,
+            "algo.fused_gather_push_deposit requires algo.use_picsar_deposition=0");
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(
+            current_deposition_algo != CurrentDepositionAlgo::DirectSupercell || !use_picsar_deposition,
+            "algo.current_deposition=direct-supercell requires algo.use_picsar_deposition=0");
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(
+            current_deposition_algo != CurrentDepositionAlgo::DirectSupercell || !fused_gather_push_deposit,
+            "algo.current_deposition=direct-supercell is not available with algo.fused_gather_push_deposit=1");
     }
 
 #ifdef WARPX_USE_PSATD
@@ -616,6 +675,8 @@ WarpX::ClearLevel (int lev)
 
 	Efield_cax[lev][i].reset();
 	Bfield_cax[lev][i].reset();
+        Efield_cdiff[lev][i].reset();
+        Bfield_cdiff[lev][i].reset();
         current_buf[lev][i].reset();
 
         current_fp_owner_masks[lev][i].reset();
@@ -706,6 +767,16 @@ WarpX::AllocLevelData (int lev, const BoxArray& ba, const DistributionMapping& d
         ngJz = std::max(ngJz,2);
     }
 
+    // The communication-avoiding FDTD update advances B in 2 guard cells
+    // (whose stencil reaches 1 cell further), then E in 1 guard cell,
+    // before the single exchange at the end of the step.
+    // Round up to 4, to keep an even number of guard cells.
+    if (do_comm_avoiding_fdtd) {
+        ngx = std::max(ngx,4);
+        ngy = std::max(ngy,4);
+        ngz = std::max(ngz,4);
+    }
+
 #if (AMREX_SPACEDIM == 3)
     IntVect ngE(ngx,ngy,ngz);
     IntVect ngJ(ngJx,ngJy,ngJz);
@@ -866,6 +937,12 @@ WarpX::AllocLevelMFs (int lev, const BoxArray& ba, const DistributionMapping& dm
         Efield_cp[lev][1].reset( new MultiFab(amrex::convert(cba,Ey_nodal_flag),dm,1,ngE));
         Efield_cp[lev][2].reset( new MultiFab(amrex::convert(cba,Ez_nodal_flag),dm,1,ngE));
 
+        // Create the workspace used in UpdateAuxilaryData
+        for (int idir = 0; idir < 3; ++idir) {
+            Bfield_cdiff[lev][idir].reset( new MultiFab(Bfield_cp[lev][idir]->boxArray(),dm,1,ngE));
+            Efield_cdiff[lev][idir].reset( new MultiFab(Efield_cp[lev][idir]->boxArray(),dm,1,ngE));
+        }
+
         // Create the MultiFabs for the current
         current_cp[lev][0].reset( new MultiFab(amrex::convert(cba,jx_nodal_flag),dm,1,ngJ));
         current_cp[lev][1].reset( new MultiFab(amrex::convert(cba,jy_nodal_flag),dm,1,ngJ));
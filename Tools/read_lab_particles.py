@@ -7,7 +7,31 @@ fn = "./lab_frame_data/" + 'snapshot' + str(it).zfill(5) + "/particle1/"
 
 print(fn)
 
+def read_particle_index(fn):
+    '''Read the index of an aggregated particle file
+    (warpx.boosted_frame_diag_aggregate_particles = 1).
+    Returns the attribute names, the size of a real in bytes and,
+    for each flush, the tuple (i_lab, offset in bytes, number of particles).'''
+    with open(os.path.join(fn, 'particles_index')) as f:
+        names = f.readline().split()
+        real_size = int(f.readline())
+        blocks = [tuple(int(v) for v in line.split()) for line in f if line.strip()]
+    return names, real_size, blocks
+
 def get_particle_field(field):
+    if os.path.exists(os.path.join(fn, 'particles_index')):
+        # Aggregated layout: one contiguous block per flush, holding
+        # all attributes one after the other
+        names, real_size, blocks = read_particle_index(fn)
+        dtype = 'float64' if real_size == 8 else 'float32'
+        k = names.index(field)
+        all_data = []
+        with open(os.path.join(fn, 'particles'), 'rb') as f:
+            for i_lab, offset, np_block in blocks:
+                f.seek(offset + k*np_block*real_size)
+                all_data.append(np.fromfile(f, dtype, np_block))
+        return np.concatenate(all_data) if all_data else np.array([])
+    # One file per attribute, per rank and per flush
     files = glob(os.path.join(fn, field + '_*'))
     all_data = np.array([])
     files.sort()
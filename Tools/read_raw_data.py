@@ -131,6 +131,8 @@ def read_lab_snapshot(snapshot, global_header):
 # It should be OpenPMD-compliant hdf5 files soon, making this part outdated.
 def get_particle_field(snapshot, species, field):
     fn = snapshot + '/' + species
+    if os.path.exists(os.path.join(fn, 'particles_index')):
+        return _get_aggregated_particle_field(fn, field)
     files = glob(os.path.join(fn, field + '_*'))
     files.sort()
     all_data = np.array([])
@@ -139,6 +141,26 @@ def get_particle_field(snapshot, species, field):
         all_data = np.concatenate((all_data, data))
     return all_data
 
+def _get_aggregated_particle_field(fn, field):
+    # Aggregated layout (warpx.boosted_frame_diag_aggregate_particles = 1):
+    # 'particles' holds one contiguous block per flush, with all attributes
+    # one after the other; 'particles_index' lists the attribute names, the
+    # size of a real, and (i_lab, offset in bytes, number of particles)
+    # for each block.
+    with open(os.path.join(fn, 'particles_index')) as f:
+        names = f.readline().split()
+        real_size = int(f.readline())
+        blocks = [[int(v) for v in line.split()] for line in f if line.strip()]
+    dtype = 'float64' if real_size == 8 else 'float32'
+    k = names.index(field)
+    all_data = np.array([])
+    with open(os.path.join(fn, 'particles'), 'rb') as f:
+        for i_lab, offset, np_block in blocks:
+            f.seek(offset + k*np_block*real_size)
+            data = np.fromfile(f, dtype, np_block)
+            all_data = np.concatenate((all_data, data))
+    return all_data
+
 def _get_field_names(raw_file):
     header_files = glob(raw_file + "*_H")
     return [hf.split("/")[-1][:-2] for hf in header_files]